@@ -0,0 +1,342 @@
+#include "AjusteCorey.h"
+#include "KernelCoreySimd.h"
+#include "GeradorPhilox.h"
+#include <algorithm> // Para std::min, std::max
+#include <cmath>     // Para std::log, std::sqrt, std::abs
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/// Caixa de valores aceitáveis: saturações, Kr máximos e expoentes.
+const double SATURACAO_MAXIMA = 0.9;
+const double SOMA_SATURACOES_MAXIMA = 0.98;
+const double KR_MAXIMO = 2.0;
+const double EXPOENTE_MINIMO = 0.2;
+const double EXPOENTE_MAXIMO = 12.0;
+
+/// Critérios de parada do Levenberg-Marquardt.
+const std::size_t ITERACOES_MAXIMAS = 300;
+const double REDUCAO_MINIMA = 1e-12;     // redução relativa do custo
+const double PASSO_MINIMO = 1e-12;       // maior variação de parâmetro
+const double AMORTECIMENTO_MAXIMO = 1e12;
+
+/**
+ * @brief Resolve (A) x = b para A 6x6 simétrica positiva definida (Cholesky).
+ * @return false se A não for positiva definida.
+ */
+bool resolverCholesky(std::array<double, 36> a, std::array<double, 6>& x, const std::array<double, 6>& b) {
+    // 1. Fatoração A = L L^T (L guardada no triângulo inferior de a)
+    for (int j = 0; j < 6; ++j) {
+        double d = a[j * 6 + j];
+        for (int k = 0; k < j; ++k) {
+            d -= a[j * 6 + k] * a[j * 6 + k];
+        }
+        if (!(d > 0.0)) {
+            return false;
+        }
+        a[j * 6 + j] = std::sqrt(d);
+        for (int i = j + 1; i < 6; ++i) {
+            double s = a[i * 6 + j];
+            for (int k = 0; k < j; ++k) {
+                s -= a[i * 6 + k] * a[j * 6 + k];
+            }
+            a[i * 6 + j] = s / a[j * 6 + j];
+        }
+    }
+
+    // 2. Substituições L y = b e L^T x = y
+    for (int i = 0; i < 6; ++i) {
+        double s = b[i];
+        for (int k = 0; k < i; ++k) {
+            s -= a[i * 6 + k] * x[k];
+        }
+        x[i] = s / a[i * 6 + i];
+    }
+    for (int i = 5; i >= 0; --i) {
+        double s = x[i];
+        for (int k = i + 1; k < 6; ++k) {
+            s -= a[k * 6 + i] * x[k];
+        }
+        x[i] = s / a[i * 6 + i];
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Construtor: copia a tabela e confere se há pontos suficientes.
+ */
+AjusteCorey::AjusteCorey(const TabelaKr& tabela, std::size_t nInicios, std::uint64_t semente)
+: _sw(tabela.sw), _krw(tabela.krw), _kro(tabela.kro), _nInicios(std::max<std::size_t>(1, nInicios)), _semente(semente) {
+    if (_sw.size() < 3) {
+        throw std::runtime_error("Erro: O ajuste de Corey precisa de pelo menos 3 pontos na tabela de Kr.");
+    }
+}
+
+/**
+ * @brief Projeta os parâmetros na caixa física.
+ * @param p Parâmetros (swir, sorw, krw_max, kro_max, nw, no).
+ */
+void AjusteCorey::projetar(Vetor6& p) {
+    p[0] = std::min(std::max(p[0], 0.0), SATURACAO_MAXIMA);
+    p[1] = std::min(std::max(p[1], 0.0), SATURACAO_MAXIMA);
+    double excesso = p[0] + p[1] - SOMA_SATURACOES_MAXIMA;
+    if (excesso > 0.0) {
+        p[0] = std::max(0.0, p[0] - 0.5 * excesso);
+        p[1] = SOMA_SATURACOES_MAXIMA - p[0];
+    }
+    p[2] = std::min(std::max(p[2], 0.0), KR_MAXIMO);
+    p[3] = std::min(std::max(p[3], 0.0), KR_MAXIMO);
+    p[4] = std::min(std::max(p[4], EXPOENTE_MINIMO), EXPOENTE_MAXIMO);
+    p[5] = std::min(std::max(p[5], EXPOENTE_MINIMO), EXPOENTE_MAXIMO);
+}
+
+/**
+ * @brief Avalia a soma dos quadrados e, se pedido, J^T J e J^T r.
+ * @param p Parâmetros.
+ * @param potW Área de trabalho para s^nw.
+ * @param potO Área de trabalho para (1 - s)^no.
+ * @param jtj Saída opcional J^T J.
+ * @param jtr Saída opcional J^T r.
+ * @return A soma dos quadrados dos resíduos.
+ */
+double AjusteCorey::avaliar(const Vetor6& p, std::vector<double>& potW, std::vector<double>& potO,
+                            std::array<double, 36>* jtj, Vetor6* jtr) const {
+    const std::size_t n = _sw.size();
+    const double inv = 1.0 / (1.0 - p[0] - p[1]);
+
+    // 1. Potências de todos os pontos numa chamada ao kernel (amplitudes unitárias)
+    ParametrosKernelCorey k;
+    k.swir = p[0];
+    k.inversoDenominador = inv;
+    k.krw_max = 1.0;
+    k.kro_max = 1.0;
+    k.nw = p[4];
+    k.no = p[5];
+    KernelCoreySimd::calcularKr(k, _sw.data(), potW.data(), potO.data(), n);
+
+    if (jtj != nullptr) {
+        jtj->fill(0.0);
+        jtr->fill(0.0);
+    }
+
+    double custo = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        // 2. Resíduos de Krw e Kro
+        double rw = p[2] * potW[i] - _krw[i];
+        double ro = p[3] * potO[i] - _kro[i];
+        custo += rw * rw + ro * ro;
+        if (jtj == nullptr) {
+            continue;
+        }
+
+        // 3. Linhas do Jacobiano analítico (ordem swir, sorw, krw_max, kro_max, nw, no)
+        //    ds/dSwir = (s - 1) / D, ds/dSorw = s / D; fora de (0, 1) s está travado
+        Vetor6 gw{0.0, 0.0, potW[i], 0.0, 0.0, 0.0};
+        Vetor6 go{0.0, 0.0, 0.0, potO[i], 0.0, 0.0};
+        double s = (_sw[i] - p[0]) * inv;
+        if (s > 0.0 && s < 1.0) {
+            double dKrwdS = p[2] * p[4] * potW[i] / s;
+            double dKrodS = -p[3] * p[5] * potO[i] / (1.0 - s);
+            double dSdSwir = (s - 1.0) * inv;
+            double dSdSorw = s * inv;
+            gw[0] = dKrwdS * dSdSwir;
+            gw[1] = dKrwdS * dSdSorw;
+            gw[4] = p[2] * potW[i] * std::log(s);
+            go[0] = dKrodS * dSdSwir;
+            go[1] = dKrodS * dSdSorw;
+            go[5] = p[3] * potO[i] * std::log(1.0 - s);
+        }
+
+        // 4. Acumulação em J^T J (triângulo inferior) e J^T r
+        for (int a = 0; a < 6; ++a) {
+            (*jtr)[a] += gw[a] * rw + go[a] * ro;
+            for (int b = 0; b <= a; ++b) {
+                (*jtj)[a * 6 + b] += gw[a] * gw[b] + go[a] * go[b];
+            }
+        }
+    }
+
+    if (jtj != nullptr) {
+        for (int a = 0; a < 6; ++a) {
+            for (int b = a + 1; b < 6; ++b) {
+                (*jtj)[a * 6 + b] = (*jtj)[b * 6 + a];
+            }
+        }
+    }
+    return custo;
+}
+
+/**
+ * @brief Levenberg-Marquardt com projeção na caixa.
+ * @param p Ponto inicial.
+ * @param iteracoes Recebe o número de iterações.
+ * @param custo Recebe a soma dos quadrados final.
+ * @return Os parâmetros ajustados.
+ */
+AjusteCorey::Vetor6 AjusteCorey::levenbergMarquardt(Vetor6 p, std::size_t& iteracoes, double& custo) const {
+    std::vector<double> potW(_sw.size());
+    std::vector<double> potO(_sw.size());
+    std::array<double, 36> jtj;
+    Vetor6 jtr;
+
+    projetar(p);
+    custo = avaliar(p, potW, potO, &jtj, &jtr);
+    double amortecimento = 1e-3;
+
+    for (iteracoes = 1; iteracoes <= ITERACOES_MAXIMAS; ++iteracoes) {
+        // 1. Sistema amortecido (J^T J + lambda * diag(J^T J)) delta = -J^T r
+        std::array<double, 36> a = jtj;
+        Vetor6 b;
+        for (int i = 0; i < 6; ++i) {
+            a[i * 6 + i] += amortecimento * std::max(jtj[i * 6 + i], 1e-12);
+            b[i] = -jtr[i];
+        }
+        Vetor6 delta;
+        if (!resolverCholesky(a, delta, b)) {
+            amortecimento *= 10.0;
+            if (amortecimento > AMORTECIMENTO_MAXIMO) {
+                break;
+            }
+            continue;
+        }
+
+        // 2. Passo projetado na caixa
+        Vetor6 tentativa = p;
+        double maiorPasso = 0.0;
+        for (int i = 0; i < 6; ++i) {
+            tentativa[i] += delta[i];
+        }
+        projetar(tentativa);
+        for (int i = 0; i < 6; ++i) {
+            maiorPasso = std::max(maiorPasso, std::abs(tentativa[i] - p[i]));
+        }
+
+        // 3. Aceita se o custo cai; senão aumenta o amortecimento
+        double custoTentativa = avaliar(tentativa, potW, potO, nullptr, nullptr);
+        if (custoTentativa < custo) {
+            double reducao = (custo - custoTentativa) / custo;
+            p = tentativa;
+            custo = custoTentativa;
+            amortecimento = std::max(amortecimento * 0.1, 1e-12);
+            if (reducao < REDUCAO_MINIMA || maiorPasso < PASSO_MINIMO || custo == 0.0) {
+                break;
+            }
+            custo = avaliar(p, potW, potO, &jtj, &jtr);
+        } else {
+            amortecimento *= 10.0;
+            if (amortecimento > AMORTECIMENTO_MAXIMO || maiorPasso < PASSO_MINIMO) {
+                break;
+            }
+        }
+    }
+    iteracoes = std::min(iteracoes, ITERACOES_MAXIMAS);
+    return p;
+}
+
+/**
+ * @brief Estimativa inicial: Swir e Sorw pelos pontos extremos com Kr nulo,
+ * Kr máximos pelos maiores valores da tabela e expoentes iguais a 2.
+ */
+AjusteCorey::Vetor6 AjusteCorey::estimativaInicial() const {
+    double maxKrw = *std::max_element(_krw.begin(), _krw.end());
+    double maxKro = *std::max_element(_kro.begin(), _kro.end());
+    double minSw = *std::min_element(_sw.begin(), _sw.end());
+    double maxSw = *std::max_element(_sw.begin(), _sw.end());
+
+    // Swir: maior Sw com Krw desprezível; Sorw: 1 - menor Sw com Kro desprezível
+    double swir = minSw;
+    double swSemOleo = maxSw;
+    for (std::size_t i = 0; i < _sw.size(); ++i) {
+        if (_krw[i] <= 1e-6 * maxKrw) {
+            swir = std::max(swir, _sw[i]);
+        }
+        if (_kro[i] <= 1e-6 * maxKro) {
+            swSemOleo = std::min(swSemOleo, _sw[i]);
+        }
+    }
+
+    Vetor6 p{swir, 1.0 - swSemOleo, maxKrw, maxKro, 2.0, 2.0};
+    projetar(p);
+    return p;
+}
+
+/**
+ * @brief Ajusta a partir de todos os pontos iniciais, em paralelo.
+ * @param pool Pool de threads.
+ * @return O melhor ajuste.
+ */
+ResultadoAjusteCorey AjusteCorey::ajustar(PoolDeThreads& pool) const {
+    // 1. Pontos iniciais: a estimativa heurística e sorteios na caixa
+    const Vetor6 heuristica = estimativaInicial();
+    const GeradorPhilox gerador(_semente);
+    std::vector<Vetor6> finais(_nInicios);
+    std::vector<double> custos(_nInicios, std::numeric_limits<double>::infinity());
+    std::vector<std::size_t> iteracoes(_nInicios, 0);
+
+    pool.paraCadaBloco(_nInicios, 1, [&](std::size_t inicio, std::size_t fim) {
+        for (std::size_t i = inicio; i < fim; ++i) {
+            Vetor6 p = heuristica;
+            if (i > 0) {
+                double u[6];
+                gerador.uniformes(i, 0, u[0], u[1]);
+                gerador.uniformes(i, 1, u[2], u[3]);
+                gerador.uniformes(i, 2, u[4], u[5]);
+                p[0] = 0.5 * u[0];
+                p[1] = 0.5 * u[1];
+                p[2] = heuristica[2] * (0.5 + u[2]);
+                p[3] = heuristica[3] * (0.5 + u[3]);
+                p[4] = 1.0 + 5.0 * u[4];
+                p[5] = 1.0 + 5.0 * u[5];
+            }
+            // 2. Cada início escreve apenas na sua posição
+            finais[i] = levenbergMarquardt(p, iteracoes[i], custos[i]);
+        }
+    });
+
+    // 3. Melhor ajuste (empate: menor índice, independente das threads)
+    std::size_t melhor = 0;
+    for (std::size_t i = 1; i < _nInicios; ++i) {
+        if (custos[i] < custos[melhor]) {
+            melhor = i;
+        }
+    }
+
+    const Vetor6& p = finais[melhor];
+    ResultadoAjusteCorey resultado;
+    resultado.parametros = ParametrosCorey{p[0], p[1], p[2], p[3], p[4], p[5]};
+    resultado.rms = std::sqrt(custos[melhor] / static_cast<double>(2 * _sw.size()));
+    resultado.iteracoes = iteracoes[melhor];
+    resultado.inicio = melhor;
+    return resultado;
+}
+
+/**
+ * @brief Grava um arquivo de entrada Corey com os parâmetros ajustados.
+ * @param resultado O ajuste.
+ * @param mu_o Viscosidade do óleo.
+ * @param mu_w Viscosidade da água.
+ * @param arquivo O arquivo de saída.
+ */
+void AjusteCorey::salvarArquivoCorey(const ResultadoAjusteCorey& resultado, double mu_o, double mu_w,
+                                     const std::string& arquivo) {
+    std::ofstream saida(arquivo);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro: Nao foi possivel criar o arquivo do ajuste: " + arquivo);
+    }
+    saida.precision(10);
+    const ParametrosCorey& p = resultado.parametros;
+    saida << "# Parametros de Corey ajustados a tabela de Kr (RMS = " << resultado.rms << ")\n"
+          << "VISC_OLEO " << mu_o << "\n"
+          << "VISC_AGUA " << mu_w << "\n"
+          << "MODELO_KR COREY\n"
+          << "COREY_SWIR     " << p.swir << "\n"
+          << "COREY_SORW     " << p.sorw << "\n"
+          << "COREY_KRW_MAX  " << p.krw_max << "\n"
+          << "COREY_KRO_MAX  " << p.kro_max << "\n"
+          << "COREY_NW       " << p.nw << "\n"
+          << "COREY_NO       " << p.no << "\n";
+}
@@ -0,0 +1,130 @@
+#ifndef AJUSTECOREY_H
+#define AJUSTECOREY_H
+
+#include "CurvasPermeabilidadeCorey.h"
+#include "CurvasPermeabilidadeTabelada.h"
+#include "PoolDeThreads.h"
+#include <array>
+#include <string>
+#include <vector>
+#include <cstddef> // Para std::size_t
+#include <cstdint>
+
+/**
+ * @struct ResultadoAjusteCorey
+ * @brief Melhor conjunto de parâmetros de Corey encontrado para uma tabela.
+ */
+struct ResultadoAjusteCorey {
+    /// Parâmetros ajustados.
+    ParametrosCorey parametros;
+
+    /// Raiz do erro quadrático médio sobre os 2n resíduos (Krw e Kro).
+    double rms;
+
+    /// Iterações de Levenberg-Marquardt do melhor início.
+    std::size_t iteracoes;
+
+    /// Índice do início (0 = estimativa heurística) que levou ao melhor ajuste.
+    std::size_t inicio;
+};
+
+/**
+ * @class AjusteCorey
+ * @brief Ajuste dos 6 parâmetros de Corey a uma tabela de Kr por mínimos quadrados.
+ *
+ * Minimiza a soma dos quadrados de (Krw_Corey - Krw_tabela) e
+ * (Kro_Corey - Kro_tabela) em todos os pontos da tabela pelo método de
+ * Levenberg-Marquardt, com escala de Marquardt (amortecimento proporcional
+ * à diagonal de J^T J) e parâmetros projetados numa caixa física.
+ *
+ * A cada iteração, s^nw e (1 - s)^no de todos os pontos são avaliados numa
+ * única chamada ao KernelCoreySimd; o Jacobiano analítico é montado a partir
+ * desses valores (sem novas potências) e acumulado diretamente em J^T J e
+ * J^T r, sem guardar a matriz 2n x 6.
+ *
+ * Para escapar de mínimos locais, o ajuste parte de vários pontos iniciais
+ * (o primeiro é uma estimativa heurística tirada da tabela; os demais são
+ * sorteados na caixa com o GeradorPhilox), resolvidos em paralelo no
+ * PoolDeThreads. O melhor resultado é o de menor erro (empate: menor
+ * índice), o mesmo para qualquer número de threads.
+ */
+class AjusteCorey {
+private:
+    /// Saturações da tabela.
+    std::vector<double> _sw;
+
+    /// Krw da tabela.
+    std::vector<double> _krw;
+
+    /// Kro da tabela.
+    std::vector<double> _kro;
+
+    /// Número de pontos iniciais.
+    std::size_t _nInicios;
+
+    /// Semente dos pontos iniciais sorteados.
+    std::uint64_t _semente;
+
+    /// Parâmetros na ordem swir, sorw, krw_max, kro_max, nw, no.
+    using Vetor6 = std::array<double, 6>;
+
+    /**
+     * @brief Projeta os parâmetros na caixa de valores fisicamente aceitáveis.
+     */
+    static void projetar(Vetor6& p);
+
+    /**
+     * @brief Soma dos quadrados dos resíduos e, opcionalmente, J^T J e J^T r.
+     * @param p Parâmetros.
+     * @param potW Área de trabalho para s^nw (n valores).
+     * @param potO Área de trabalho para (1 - s)^no (n valores).
+     * @param jtj Se não nulo, recebe J^T J (6x6, linha a linha).
+     * @param jtr Se não nulo, recebe J^T r.
+     * @return A soma dos quadrados dos resíduos.
+     */
+    double avaliar(const Vetor6& p, std::vector<double>& potW, std::vector<double>& potO,
+                   std::array<double, 36>* jtj, Vetor6* jtr) const;
+
+    /**
+     * @brief Levenberg-Marquardt a partir de um ponto inicial.
+     * @param inicial Ponto inicial (já dentro da caixa).
+     * @param iteracoes Recebe o número de iterações feitas.
+     * @param custo Recebe a soma dos quadrados final.
+     * @return Os parâmetros ajustados.
+     */
+    Vetor6 levenbergMarquardt(Vetor6 inicial, std::size_t& iteracoes, double& custo) const;
+
+    /**
+     * @brief Estimativa inicial a partir da tabela (pontos extremos e máximos).
+     */
+    Vetor6 estimativaInicial() const;
+
+public:
+    /**
+     * @brief Construtor.
+     * @param tabela Pontos (Sw, Krw, Kro) de laboratório.
+     * @param nInicios Número de pontos iniciais do multi-start (>= 1).
+     * @param semente Semente dos pontos iniciais sorteados.
+     */
+    AjusteCorey(const TabelaKr& tabela, std::size_t nInicios = 32, std::uint64_t semente = 20240101);
+
+    /**
+     * @brief Executa o ajuste, com os pontos iniciais distribuídos no pool.
+     * @param pool Pool de threads.
+     * @return O melhor ajuste encontrado.
+     */
+    ResultadoAjusteCorey ajustar(PoolDeThreads& pool) const;
+
+    /**
+     * @brief Grava um arquivo de entrada Corey com os parâmetros ajustados.
+     * O arquivo pode ser usado diretamente pelo simulador (e em varreduras).
+     * @param resultado O ajuste.
+     * @param mu_o Viscosidade do óleo (cPoise).
+     * @param mu_w Viscosidade da água (cPoise).
+     * @param arquivo O caminho do arquivo de saída.
+     */
+    static void salvarArquivoCorey(const ResultadoAjusteCorey& resultado, double mu_o, double mu_w,
+                                   const std::string& arquivo);
+};
+
+#endif
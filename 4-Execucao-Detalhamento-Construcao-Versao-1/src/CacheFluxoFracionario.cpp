@@ -0,0 +1,150 @@
+#include "CacheFluxoFracionario.h"
+#include <cmath>     // Para std::fabs, std::sqrt e std::ceil
+#include <stdexcept> // Para std::runtime_error
+#include <string>    // Para std::to_string
+
+/**
+ * @brief Constrói o cache com erro de interpolação limitado.
+ * @param calculadora A calculadora de fluxo fracionário.
+ * @param erroMaximo Erro máximo absoluto da interpolação de fw.
+ * @param comDerivada Se verdadeiro, tabela também dfw/dSw.
+ * @param maximoIntervalos Maior número de intervalos permitido.
+ */
+CacheFluxoFracionario::CacheFluxoFracionario(const CalculadoraFluxoFracionario& calculadora, double erroMaximo,
+                                             bool comDerivada, std::size_t maximoIntervalos)
+: _comDerivada(comDerivada), _erroMaximo(erroMaximo), _maximoIntervalos(maximoIntervalos) {
+    if (!(erroMaximo > 0.0)) {
+        throw std::runtime_error("Erro: O erro maximo do cache de fw deve ser positivo.");
+    }
+    if (maximoIntervalos == 0) {
+        throw std::runtime_error("Erro: O cache de fw precisa de ao menos um intervalo.");
+    }
+
+    // A primeira malha é grosseira; reconstruir refina até a tolerância
+    _intervalos = std::min(INTERVALOS_INICIAIS, maximoIntervalos);
+    reconstruir(calculadora);
+}
+
+/**
+ * @brief Tabela com um número fixo de intervalos.
+ * @param calculadora A calculadora de fluxo fracionário.
+ * @param intervalos Número de intervalos da malha.
+ * @param comDerivada Se verdadeiro, tabela também dfw/dSw.
+ */
+void CacheFluxoFracionario::tabelar(const CalculadoraFluxoFracionario& calculadora, std::size_t intervalos,
+                                    bool comDerivada) {
+    if (intervalos == 0) {
+        throw std::runtime_error("Erro: O cache de fw precisa de ao menos um intervalo.");
+    }
+
+    // Malha fixa: sem tolerância, reconstruir mantém o número de intervalos
+    _erroMaximo = 0.0;
+    _comDerivada = comDerivada;
+    tabelarMalha(calculadora, intervalos);
+}
+
+/**
+ * @brief Refaz a tabela, refinando a malha até a tolerância (se houver).
+ * @param calculadora A nova calculadora.
+ */
+void CacheFluxoFracionario::reconstruir(const CalculadoraFluxoFracionario& calculadora) {
+    if (_intervalos == 0) {
+        throw std::runtime_error("Erro: O cache de fw ainda nao foi tabelado.");
+    }
+
+    std::size_t n = _intervalos;
+    for (;;) {
+        tabelarMalha(calculadora, n);
+        if (_erroMaximo <= 0.0 || _erroEstimado <= _erroMaximo) {
+            return;
+        }
+        if (n >= _maximoIntervalos) {
+            throw std::runtime_error("Erro: O cache de fw nao atingiu o erro maximo " + std::to_string(_erroMaximo)
+                                     + " com " + std::to_string(n) + " intervalos (erro estimado "
+                                     + std::to_string(_erroEstimado) + "); aumente o maximo de intervalos.");
+        }
+
+        // O erro da interpolação linear cai com h^2: estima o fator que falta
+        // (com folga de 10%) e arredonda para uma potência de 2, no mínimo 2
+        double fator = std::ceil(1.1 * std::sqrt(_erroEstimado / _erroMaximo));
+        std::size_t multiplicador = 2;
+        while (static_cast<double>(multiplicador) < fator && multiplicador < _maximoIntervalos) {
+            multiplicador *= 2;
+        }
+        n = (n > _maximoIntervalos / multiplicador) ? _maximoIntervalos : n * multiplicador;
+    }
+}
+
+/**
+ * @brief Tabela fw (e dfw) nos nós e mede o erro em 1/4, 1/2 e 3/4 de cada intervalo.
+ * @param calculadora A calculadora de fluxo fracionário.
+ * @param intervalos Número de intervalos da malha.
+ */
+void CacheFluxoFracionario::tabelarMalha(const CalculadoraFluxoFracionario& calculadora, std::size_t intervalos) {
+    const double h = 1.0 / static_cast<double>(intervalos);
+    _intervalos = intervalos;
+
+    // 1. Nós Sw_i = i * h (mesma malha de gerarCurvaCompleta), terminando em 1.0
+    _trabalhoSw.resize(intervalos + 1);
+    for (std::size_t i = 0; i < intervalos; ++i) {
+        _trabalhoSw[i] = static_cast<double>(i) * h;
+    }
+    _trabalhoSw[intervalos] = 1.0;
+
+    _fw.resize(intervalos + 1);
+    if (!_comDerivada) {
+        _dfw.clear();
+        calculadora.calcularFwLote(_trabalhoSw.data(), _fw.data(), intervalos + 1);
+    } else {
+        _dfw.resize(intervalos + 1);
+        calculadora.calcularFwDerivadaLote(_trabalhoSw.data(), _fw.data(), _dfw.data(), intervalos + 1);
+    }
+
+    // 2. Erro da interpolação em 1/4, 1/2 e 3/4 de cada intervalo
+    _trabalhoSw.resize(AMOSTRAS_POR_INTERVALO * intervalos);
+    _trabalhoFw.resize(AMOSTRAS_POR_INTERVALO * intervalos);
+    for (std::size_t i = 0; i < intervalos; ++i) {
+        for (std::size_t k = 0; k < AMOSTRAS_POR_INTERVALO; ++k) {
+            double t = static_cast<double>(k + 1) / static_cast<double>(AMOSTRAS_POR_INTERVALO + 1);
+            _trabalhoSw[AMOSTRAS_POR_INTERVALO * i + k] = (static_cast<double>(i) + t) * h;
+        }
+    }
+    calculadora.calcularFwLote(_trabalhoSw.data(), _trabalhoFw.data(), AMOSTRAS_POR_INTERVALO * intervalos);
+
+    double maiorDesvio = 0.0;
+    for (std::size_t i = 0; i < intervalos; ++i) {
+        for (std::size_t k = 0; k < AMOSTRAS_POR_INTERVALO; ++k) {
+            double t = static_cast<double>(k + 1) / static_cast<double>(AMOSTRAS_POR_INTERVALO + 1);
+            double interpolado = _fw[i] + t * (_fw[i + 1] - _fw[i]);
+            maiorDesvio = std::max(maiorDesvio, std::fabs(_trabalhoFw[AMOSTRAS_POR_INTERVALO * i + k] - interpolado));
+        }
+    }
+
+    // Um erro côncavo (ou convexo) no intervalo vale, em algum dos três pontos,
+    // ao menos 3/4 do seu pico: o fator 4/3 torna a estimativa um limite
+    _erroEstimado = FATOR_SEGURANCA * maiorDesvio;
+}
+
+/**
+ * @brief fw para um lote de saturações.
+ * @param sw Vetor de saturações.
+ * @param fw Vetor de saída para fw.
+ * @param n Número de pontos.
+ */
+void CacheFluxoFracionario::fwLote(const double* sw, double* fw, std::size_t n) const {
+    for (std::size_t k = 0; k < n; ++k) {
+        fw[k] = this->fw(sw[k]);
+    }
+}
+
+/**
+ * @brief Maior |inclinação| de fw entre nós vizinhos.
+ */
+double CacheFluxoFracionario::maiorInclinacao() const {
+    double maior = 0.0;
+    const double h = 1.0 / static_cast<double>(_intervalos);
+    for (std::size_t i = 0; i < _intervalos; ++i) {
+        maior = std::max(maior, std::fabs(_fw[i + 1] - _fw[i]) / h);
+    }
+    return maior;
+}
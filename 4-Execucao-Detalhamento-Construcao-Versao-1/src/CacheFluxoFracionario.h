@@ -0,0 +1,173 @@
+#ifndef CACHEFLUXOFRACIONARIO_H
+#define CACHEFLUXOFRACIONARIO_H
+
+#include "CalculadoraFluxoFracionario.h"
+#include <algorithm> // Para std::min e std::max
+#include <vector>
+#include <cstddef> // Para std::size_t
+
+/**
+ * @class CacheFluxoFracionario
+ * @brief fw (e, opcionalmente, dfw/dSw) pré-tabelado numa malha uniforme de Sw.
+ *
+ * Para consumidores que avaliam fw muitas vezes (laços de transporte,
+ * previsão, otimização): a consulta é O(1), sem desvios (clamp por
+ * min/max, índice por truncamento) e sem chamadas ao modelo de Kr.
+ *
+ * O número de intervalos é escolhido pelo erro máximo de interpolação
+ * pedido: a tabela é montada, o erro é medido em 1/4, 1/2 e 3/4 de cada
+ * intervalo contra a calculadora (com um fator de segurança de 4/3) e, se
+ * passar da tolerância, o número de intervalos é multiplicado (o erro da
+ * interpolação linear cai com h^2) até atender a tolerância. Se o máximo
+ * de intervalos permitido não bastar, é lançado um erro. O erro de
+ * dfw/dSw não é controlado (a derivada de um modelo tabelado é
+ * descontínua nos pontos da tabela).
+ *
+ * As áreas de trabalho ficam no objeto: reconstruir (por exemplo, após
+ * mudar as viscosidades) parte do número de intervalos anterior e não
+ * aloca memória se a malha não crescer.
+ */
+class CacheFluxoFracionario {
+public:
+    /// Máximo padrão de intervalos: 2^15 (256 KiB de fw, cabe na L2).
+    static constexpr std::size_t MAXIMO_INTERVALOS_PADRAO = std::size_t(1) << 15;
+
+private:
+    /// Intervalos iniciais na primeira construção.
+    static constexpr std::size_t INTERVALOS_INICIAIS = 64;
+
+    /// Pontos internos de cada intervalo onde o erro é medido (1/4, 1/2 e 3/4).
+    static constexpr std::size_t AMOSTRAS_POR_INTERVALO = 3;
+
+    /// Fator sobre o maior desvio medido (o pico pode estar entre as amostras).
+    static constexpr double FATOR_SEGURANCA = 4.0 / 3.0;
+
+    /// fw nos nós Sw_i = i / intervalos (intervalos + 1 valores).
+    std::vector<double> _fw;
+
+    /// dfw/dSw nos nós (vazio se não pedido).
+    std::vector<double> _dfw;
+
+    /// Número de intervalos da malha.
+    std::size_t _intervalos = 0;
+
+    /// Se dfw/dSw também é tabelado.
+    bool _comDerivada = false;
+
+    /// Erro máximo de interpolação pedido (0 = malha fixa, sem refinamento).
+    double _erroMaximo = 0.0;
+
+    /// Maior número de intervalos permitido no refinamento.
+    std::size_t _maximoIntervalos = MAXIMO_INTERVALOS_PADRAO;
+
+    /// Erro de interpolação de fw estimado (maior desvio medido vezes FATOR_SEGURANCA).
+    double _erroEstimado = 0.0;
+
+    /// Área de trabalho: saturações dos nós e dos pontos de medição.
+    std::vector<double> _trabalhoSw;
+
+    /// Área de trabalho: fw exato nos pontos de medição.
+    std::vector<double> _trabalhoFw;
+
+    /**
+     * @brief Tabela fw (e dfw) com um número fixo de intervalos e mede o erro.
+     * @param calculadora A calculadora de fluxo fracionário.
+     * @param intervalos Número de intervalos da malha.
+     */
+    void tabelarMalha(const CalculadoraFluxoFracionario& calculadora, std::size_t intervalos);
+
+public:
+    /**
+     * @brief Cria um cache vazio (a preencher por tabelar).
+     */
+    CacheFluxoFracionario() = default;
+
+    /**
+     * @brief Constrói o cache com erro de interpolação limitado.
+     * @param calculadora A calculadora de fluxo fracionário.
+     * @param erroMaximo Erro máximo absoluto da interpolação de fw (> 0).
+     * @param comDerivada Se verdadeiro, tabela também dfw/dSw.
+     * @param maximoIntervalos Maior número de intervalos permitido.
+     * @throws std::runtime_error Se maximoIntervalos não bastar para erroMaximo.
+     */
+    CacheFluxoFracionario(const CalculadoraFluxoFracionario& calculadora, double erroMaximo,
+                          bool comDerivada = false, std::size_t maximoIntervalos = MAXIMO_INTERVALOS_PADRAO);
+
+    /**
+     * @brief Tabela com um número fixo de intervalos (sem refinamento).
+     * @param calculadora A calculadora de fluxo fracionário.
+     * @param intervalos Número de intervalos da malha (> 0).
+     * @param comDerivada Se verdadeiro, tabela também dfw/dSw.
+     */
+    void tabelar(const CalculadoraFluxoFracionario& calculadora, std::size_t intervalos, bool comDerivada = false);
+
+    /**
+     * @brief Refaz a tabela para outra calculadora (ex: novas viscosidades).
+     * Mantém a tolerância e parte do número de intervalos atual.
+     * @param calculadora A nova calculadora.
+     * @throws std::runtime_error Se o máximo de intervalos não bastar para a
+     * tolerância (a tabela fica montada com o máximo de intervalos).
+     */
+    void reconstruir(const CalculadoraFluxoFracionario& calculadora);
+
+    /**
+     * @brief fw por interpolação linear (Sw fora de [0, 1] é limitado à faixa).
+     * @param sw Saturação de água.
+     * @return O valor de fw.
+     */
+    double fw(double sw) const {
+        double u = std::min(std::max(sw, 0.0), 1.0) * static_cast<double>(_intervalos);
+        std::size_t i = std::min(static_cast<std::size_t>(u), _intervalos - 1);
+        double t = u - static_cast<double>(i);
+        return _fw[i] + t * (_fw[i + 1] - _fw[i]);
+    }
+
+    /**
+     * @brief dfw/dSw por interpolação linear (só se tabelado com derivada).
+     * @param sw Saturação de água.
+     * @return O valor de dfw/dSw.
+     */
+    double dfw(double sw) const {
+        double u = std::min(std::max(sw, 0.0), 1.0) * static_cast<double>(_intervalos);
+        std::size_t i = std::min(static_cast<std::size_t>(u), _intervalos - 1);
+        double t = u - static_cast<double>(i);
+        return _dfw[i] + t * (_dfw[i + 1] - _dfw[i]);
+    }
+
+    /**
+     * @brief fw para um lote de saturações.
+     * @param sw Vetor de entrada com as saturações (n valores).
+     * @param fw Vetor de saída para fw (n valores).
+     * @param n Número de saturações do lote.
+     */
+    void fwLote(const double* sw, double* fw, std::size_t n) const;
+
+    /**
+     * @brief Número de intervalos da malha.
+     */
+    std::size_t intervalos() const { return _intervalos; }
+
+    /**
+     * @brief Indica se dfw/dSw foi tabelado.
+     */
+    bool temDerivada() const { return _comDerivada; }
+
+    /**
+     * @brief Estimativa conservadora do erro de interpolação de fw.
+     * Maior desvio medido em 1/4, 1/2 e 3/4 dos intervalos, vezes 4/3.
+     */
+    double erroEstimado() const { return _erroEstimado; }
+
+    /**
+     * @brief Maior |inclinação| de fw entre nós vizinhos (ex: para a condição CFL).
+     */
+    double maiorInclinacao() const;
+
+    /**
+     * @brief Memória das tabelas consultadas (fw e dfw), em bytes.
+     * Não inclui as áreas de trabalho, usadas só na construção.
+     */
+    std::size_t memoriaBytes() const { return (_fw.size() + _dfw.size()) * sizeof(double); }
+};
+
+#endif
@@ -1,7 +1,5 @@
 #include "CalculadoraFluxoFracionario.h"
-#include <cmath>     // Para std::pow
 #include <stdexcept> // Para std::runtime_error
-#include <limits>    // Para checagem de divisão por zero
 
 /**
  * @brief Construtor da Calculadora.
@@ -9,16 +7,33 @@
  * @param mu_w Viscosidade da Água.
  * @param modelo Ponteiro para o modelo de Kr (injetado).
  */
-CalculadoraFluxoFracionario::CalculadoraFluxoFracionario(double mu_o, double mu_w, ICurvasPermeabilidade* modelo)
-: _viscosidadeOleo(mu_o), _viscosidadeAgua(mu_w), _modeloKr(modelo) {
+CalculadoraFluxoFracionario::CalculadoraFluxoFracionario(double mu_o, double mu_w, const ICurvasPermeabilidade* modelo)
+: _especializacao(especializar(mu_o, mu_w, modelo)) {
+}
 
-    // Validação de segurança
+/**
+ * @brief Escolhe a especialização pelo tipo concreto do modelo.
+ * @param mu_o Viscosidade do Óleo.
+ * @param mu_w Viscosidade da Água.
+ * @param modelo Ponteiro para o modelo de Kr.
+ * @return A calculadora especializada.
+ */
+CalculadoraFluxoFracionario::Especializacao
+CalculadoraFluxoFracionario::especializar(double mu_o, double mu_w, const ICurvasPermeabilidade* modelo) {
+
+    // Validação de segurança (as viscosidades são validadas pela especialização)
     if (modelo == nullptr) {
         throw std::runtime_error("Erro: Calculadora recebeu um modelo de permeabilidade nulo.");
     }
-    if (mu_o <= 0 || mu_w <= 0) {
-        throw std::runtime_error("Erro: Viscosidades devem ser positivas.");
+
+    // Despacho único: daqui em diante o tipo do modelo é conhecido em tempo de compilação
+    if (auto corey = dynamic_cast<const CurvasPermeabilidadeCorey*>(modelo)) {
+        return CalculadoraFluxoFracionarioEspecializada<CurvasPermeabilidadeCorey>(mu_o, mu_w, *corey);
+    }
+    if (auto tabelada = dynamic_cast<const CurvasPermeabilidadeTabelada*>(modelo)) {
+        return CalculadoraFluxoFracionarioEspecializada<CurvasPermeabilidadeTabelada>(mu_o, mu_w, *tabelada);
     }
+    return CalculadoraFluxoFracionarioEspecializada<ICurvasPermeabilidade>(mu_o, mu_w, *modelo);
 }
 
 /**
@@ -27,47 +42,78 @@ CalculadoraFluxoFracionario::CalculadoraFluxoFracionario(double mu_o, double mu_
  * @return O valor de fw.
  */
 double CalculadoraFluxoFracionario::calcularFw(double sw) const {
+    return despachar([sw](const auto& calc) { return calc.calcularFw(sw); });
+}
 
-    // 1. Pedir os valores de Kr para o modelo (Strategy Pattern)
-    double krw = _modeloKr->getKrw(sw);
-    double kro = _modeloKr->getKro(sw);
-
-    // 2. Implementar a Equação de Buckley-Leverett
-
-    // Razão de mobilidade da água: Lambda_w = krw / mu_w
-    double lambda_w = krw / _viscosidadeAgua;
-
-    // Razão de mobilidade do óleo: Lambda_o = kro / mu_o
-    double lambda_o = kro / _viscosidadeOleo;
-
-    // Mobilidade Total: Lambda_t = Lambda_w + Lambda_o
-    double lambda_t = lambda_w + lambda_o;
-
-    // Fórmula do Fluxo Fracionário: fw = Lambda_w / Lambda_t
-
-    // Checagem de segurança para divisão por zero
-    if (lambda_t < std::numeric_limits<double>::epsilon()) {
-        // Se a mobilidade total é zero (ambos krw e kro são 0),
-        // o fluxo fracionário também é zero.
-        return 0.0;
-    }
+/**
+ * @brief Calcula o fluxo fracionário para um lote de saturações.
+ * @param sw Vetor de saturações de água.
+ * @param fw Vetor de saída para fw.
+ * @param n Número de pontos.
+ */
+void CalculadoraFluxoFracionario::calcularFwLote(const double* sw, double* fw, std::size_t n) const {
+    despachar([&](const auto& calc) { calc.calcularFwLote(sw, fw, n); });
+}
 
-    return lambda_w / lambda_t;
+/**
+ * @brief Calcula fw e dfw/dSw para um lote de saturações.
+ * @param sw Vetor de saturações de água.
+ * @param fw Vetor de saída para fw.
+ * @param dfw Vetor de saída para dfw/dSw.
+ * @param n Número de pontos.
+ */
+void CalculadoraFluxoFracionario::calcularFwDerivadaLote(const double* sw, double* fw, double* dfw, std::size_t n) const {
+    despachar([&](const auto& calc) { calc.calcularFwDerivadaLote(sw, fw, dfw, n); });
 }
 
 /**
  * @brief Gera a curva completa de fw vs Sw.
  * @param passo O incremento de Saturação (ex: 0.01 para 1%).
- * @return Um mapa (map) contendo os pares (Sw, Fw).
+ * @return A curva (Sw, Fw) em vetores contíguos.
  */
-std::map<double, double> CalculadoraFluxoFracionario::gerarCurvaCompleta(double passo) const {
-    std::map<double, double> curva;
+CurvaFluxoFracionario CalculadoraFluxoFracionario::gerarCurvaCompleta(double passo) const {
+    return despachar([passo](const auto& calc) { return calc.gerarCurvaCompleta(passo); });
+}
 
-    for (double sw = 0.0; sw <= 1.0; sw += passo) {
-        curva[sw] = calcularFw(sw);
-    }
-    // Garante que o ponto final (1.0) seja sempre calculado
-    curva[1.0] = calcularFw(1.0);
+/**
+ * @brief Gera a curva de fw vs Sw com a coluna dfw/dSw.
+ * @param passo O incremento de Saturação.
+ * @return A curva (Sw, Fw, dfw/dSw).
+ */
+CurvaFluxoFracionario CalculadoraFluxoFracionario::gerarCurvaComDerivada(double passo) const {
+    return despachar([passo](const auto& calc) { return calc.gerarCurvaComDerivada(passo); });
+}
+
+/**
+ * @brief Avalia Krw e Kro uma única vez na malha uniforme.
+ * @param passo O incremento de Saturação.
+ * @param comDerivada Se também avalia as derivadas.
+ * @return Kr na malha.
+ */
+KrNaMalha CalculadoraFluxoFracionario::avaliarKrNaMalha(double passo, bool comDerivada) const {
+    return despachar([&](const auto& calc) { return calc.avaliarKrNaMalha(passo, comDerivada); });
+}
 
-    return curva;
+/**
+ * @brief Gera as curvas de fw de vários pares de viscosidades.
+ * @param passo O incremento de Saturação.
+ * @param pares Os pares (mu_o, mu_w).
+ * @param comDerivada Se as curvas devem trazer a coluna dfw/dSw.
+ * @return Uma curva por par.
+ */
+std::vector<CurvaFluxoFracionario> CalculadoraFluxoFracionario::gerarCurvasViscosidades(
+    double passo, const std::vector<ParViscosidades>& pares, bool comDerivada) const {
+    return despachar([&](const auto& calc) { return calc.gerarCurvasViscosidades(passo, pares, comDerivada); });
+}
+
+/**
+ * @brief Gera a curva de fw vs Sw com amostragem adaptativa.
+ * @param tolerancia Erro máximo de interpolação linear de fw.
+ * @param comDerivada Se a curva deve trazer a coluna dfw/dSw.
+ * @param passoMinimo Menor largura de intervalo.
+ * @return A curva em ordem crescente de Sw.
+ */
+CurvaFluxoFracionario CalculadoraFluxoFracionario::gerarCurvaAdaptativa(double tolerancia, bool comDerivada,
+                                                                        double passoMinimo) const {
+    return despachar([&](const auto& calc) { return calc.gerarCurvaAdaptativa(tolerancia, comDerivada, passoMinimo); });
 }
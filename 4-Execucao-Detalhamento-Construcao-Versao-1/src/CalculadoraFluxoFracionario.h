@@ -2,8 +2,15 @@
 #define CALCULADORAFLUXOFRACIONARIO_H
 
 #include "ICurvasPermeabilidade.h"
-#include <map>
+#include "CurvasPermeabilidadeCorey.h"
+#include "CurvasPermeabilidadeTabelada.h"
+#include "CalculadoraFluxoFracionarioEspecializada.h"
+#include "CurvaFluxoFracionario.h"
 #include <string> // Incluído para std::string
+#include <cstddef> // Para std::size_t
+#include <utility> // Para std::forward
+#include <variant> // Para std::variant e std::visit
+#include <vector>
 
 /**
  * @class CalculadoraFluxoFracionario
@@ -12,17 +19,34 @@
  * Esta classe é responsável por implementar a equação de Buckley-Leverett.
  * Ela depende de uma abstração (ICurvasPermeabilidade) e não de uma
  * implementação concreta, seguindo o Princípio da Inversão de Dependência.
+ *
+ * Internamente é um adaptador fino: no construtor, o tipo concreto do modelo
+ * é identificado uma única vez e guardado como uma
+ * CalculadoraFluxoFracionarioEspecializada (Corey, tabelado ou, para outros
+ * modelos, a versão genérica com despacho virtual). Cada chamada pública faz
+ * um único desvio para a especialização; o laço interno não tem chamadas
+ * virtuais. Quem precisa de um laço próprio sem nenhum desvio por ponto
+ * usa despachar().
  */
 class CalculadoraFluxoFracionario {
-private:
-    /// Viscosidade do Óleo (cPoise)
-    double _viscosidadeOleo;
+public:
+    /// Calculadora especializada escolhida no construtor.
+    using Especializacao = std::variant<CalculadoraFluxoFracionarioEspecializada<CurvasPermeabilidadeCorey>,
+                                        CalculadoraFluxoFracionarioEspecializada<CurvasPermeabilidadeTabelada>,
+                                        CalculadoraFluxoFracionarioEspecializada<ICurvasPermeabilidade>>;
 
-    /// Viscosidade da Água (cPoise)
-    double _viscosidadeAgua;
+private:
+    /// Especialização para o tipo concreto do modelo de Kr (Strategy Pattern resolvido uma vez)
+    Especializacao _especializacao;
 
-    /// Ponteiro para o modelo de Kr (Strategy Pattern)
-    ICurvasPermeabilidade* _modeloKr;
+    /**
+     * @brief Escolhe a especialização correspondente ao tipo concreto do modelo.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param modelo O modelo de Kr (não nulo).
+     * @return A calculadora especializada.
+     */
+    static Especializacao especializar(double mu_o, double mu_w, const ICurvasPermeabilidade* modelo);
 
 public:
     /**
@@ -32,7 +56,20 @@ public:
      * @param mu_w Viscosidade da Água (cPoise).
      * @param modelo Um ponteiro para um objeto que implementa ICurvasPermeabilidade.
      */
-    CalculadoraFluxoFracionario(double mu_o, double mu_w, ICurvasPermeabilidade* modelo);
+    CalculadoraFluxoFracionario(double mu_o, double mu_w, const ICurvasPermeabilidade* modelo);
+
+    /**
+     * @brief Executa f com a calculadora especializada (despacho único).
+     * f recebe uma CalculadoraFluxoFracionarioEspecializada<ModeloKr> e é
+     * instanciada para cada tipo de modelo, de modo que um laço escrito
+     * dentro de f chama o modelo concreto sem desvio por ponto.
+     * @param f Objeto chamável genérico (ex: lambda com parâmetro auto).
+     * @return O que f retornar.
+     */
+    template <typename Funcao>
+    decltype(auto) despachar(Funcao&& f) const {
+        return std::visit(std::forward<Funcao>(f), _especializacao);
+    }
 
     /**
      * @brief Calcula um único ponto da curva de fluxo fracionário.
@@ -41,12 +78,74 @@ public:
      */
     double calcularFw(double sw) const;
 
+    /**
+     * @brief Calcula o fluxo fracionário para um lote de saturações.
+     * Processa o lote em blocos, chamando o modelo concreto diretamente.
+     * @param sw Vetor de entrada com as saturações de água (n valores).
+     * @param fw Vetor de saída para os valores de fw (n valores, alocado pelo chamador).
+     * @param n Número de saturações do lote.
+     */
+    void calcularFwLote(const double* sw, double* fw, std::size_t n) const;
+
+    /**
+     * @brief Calcula fw e dfw/dSw para um lote de saturações, em uma única passada.
+     * Usa as derivadas analíticas do modelo de Kr:
+     * dfw/dSw = (Lambda_w' * Lambda_o - Lambda_w * Lambda_o') / Lambda_t^2.
+     * @param sw Vetor de entrada com as saturações de água (n valores).
+     * @param fw Vetor de saída para fw.
+     * @param dfw Vetor de saída para dfw/dSw.
+     * @param n Número de saturações do lote.
+     */
+    void calcularFwDerivadaLote(const double* sw, double* fw, double* dfw, std::size_t n) const;
+
     /**
      * @brief Gera a curva completa de Fw vs Sw, iterando sobre a saturação.
+     * A malha é indexada por inteiros (Sw_i = i * passo) e termina exatamente em 1.0.
+     * @param passo O incremento de Saturação (ex: 0.01 para 1%).
+     * @return A curva (Sw, Fw) em vetores contíguos.
+     */
+    CurvaFluxoFracionario gerarCurvaCompleta(double passo) const;
+
+    /**
+     * @brief Gera a curva Fw vs Sw já com a coluna dfw/dSw.
      * @param passo O incremento de Saturação (ex: 0.01 para 1%).
-     * @return Um mapa (std::map) contendo os pares (Sw, Fw) da curva.
+     * @return A curva (Sw, Fw, dfw/dSw) em vetores contíguos.
+     */
+    CurvaFluxoFracionario gerarCurvaComDerivada(double passo) const;
+
+    /**
+     * @brief Avalia Krw e Kro uma única vez na malha uniforme de passo.
+     * O resultado independe das viscosidades; KrNaMalha::curvaFw gera a
+     * curva de fw de qualquer par sem chamar o modelo de novo.
+     * @param passo O incremento de Saturação.
+     * @param comDerivada Se também avalia as derivadas (curvas com dfw/dSw).
+     * @return Kr na malha de gerarCurvaCompleta(passo).
+     */
+    KrNaMalha avaliarKrNaMalha(double passo, bool comDerivada = false) const;
+
+    /**
+     * @brief Gera as curvas de fw de vários pares de viscosidades.
+     * Kr é avaliado uma única vez na malha; cada par custa só o laço da
+     * equação de fw. As viscosidades da calculadora não são usadas.
+     * @param passo O incremento de Saturação.
+     * @param pares Os pares (mu_o, mu_w).
+     * @param comDerivada Se as curvas devem trazer a coluna dfw/dSw.
+     * @return Uma curva por par, na ordem de pares.
+     */
+    std::vector<CurvaFluxoFracionario> gerarCurvasViscosidades(double passo, const std::vector<ParViscosidades>& pares,
+                                                               bool comDerivada = false) const;
+
+    /**
+     * @brief Gera a curva Fw vs Sw com amostragem adaptativa.
+     * Refina onde o erro da interpolação linear passa da tolerância e inclui
+     * exatamente os pontos de quebra do modelo de Kr; ver
+     * CalculadoraFluxoFracionarioEspecializada::gerarCurvaAdaptativa.
+     * @param tolerancia Erro máximo de interpolação linear de fw (> 0).
+     * @param comDerivada Se a curva deve trazer a coluna dfw/dSw.
+     * @param passoMinimo Menor largura de intervalo.
+     * @return A curva em ordem crescente de Sw.
      */
-    std::map<double, double> gerarCurvaCompleta(double passo) const;
+    CurvaFluxoFracionario gerarCurvaAdaptativa(double tolerancia, bool comDerivada, double passoMinimo = 1e-6) const;
 };
 
 #endif
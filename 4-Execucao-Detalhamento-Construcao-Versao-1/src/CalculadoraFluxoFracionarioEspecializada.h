@@ -0,0 +1,483 @@
+#ifndef CALCULADORAFLUXOFRACIONARIOESPECIALIZADA_H
+#define CALCULADORAFLUXOFRACIONARIOESPECIALIZADA_H
+
+#include "CurvaFluxoFracionario.h"
+#include <algorithm> // Para std::min, std::sort e std::unique
+#include <cmath>     // Para std::ceil e std::fabs
+#include <cstddef>   // Para std::size_t
+#include <limits>    // Para checagem de divisão por zero
+#include <numeric>   // Para std::iota
+#include <stdexcept> // Para std::runtime_error
+#include <utility>   // Para std::pair
+#include <vector>
+
+/**
+ * @struct EquacaoFluxoFracionario
+ * @brief A equação de Buckley-Leverett aplicada a valores de Kr já calculados.
+ *
+ * Escrita sem desvios (seleções em vez de if) para que os laços que a
+ * chamam possam ser vetorizados. Recebe os inversos das viscosidades,
+ * calculados uma vez por quem a chama: as mobilidades saem de produtos, não
+ * de divisões. Usada pela calculadora, por KrNaMalha e por TabelasKrRegioes,
+ * que assim dão exatamente os mesmos resultados.
+ */
+struct EquacaoFluxoFracionario {
+    /**
+     * @brief fw de um par (Krw, Kro).
+     * @param krw Permeabilidade relativa da água.
+     * @param kro Permeabilidade relativa do óleo.
+     * @param inversoMu_o 1 / Viscosidade do Óleo (1/cPoise).
+     * @param inversoMu_w 1 / Viscosidade da Água (1/cPoise).
+     * @return O valor do fluxo fracionário (fw).
+     */
+    static double fw(double krw, double kro, double inversoMu_o, double inversoMu_w) {
+        // Mobilidades: Lambda = kr / mu
+        double lambda_w = krw * inversoMu_w;
+        double lambda_o = kro * inversoMu_o;
+        double lambda_t = lambda_w + lambda_o;
+
+        // Mobilidade total nula (krw = kro = 0): fw = 0. O divisor é trocado
+        // antes da divisão para não dividir por zero.
+        bool nula = lambda_t < std::numeric_limits<double>::epsilon();
+        double f = lambda_w / (nula ? 1.0 : lambda_t);
+        return nula ? 0.0 : f;
+    }
+
+    /**
+     * @brief fw e dfw/dSw de um ponto, a partir de Kr e das derivadas de Kr.
+     * dfw/dSw = (Lambda_w' * Lambda_o - Lambda_w * Lambda_o') / Lambda_t^2.
+     * @param krw Krw.
+     * @param kro Kro.
+     * @param dkrw dKrw/dSw.
+     * @param dkro dKro/dSw.
+     * @param inversoMu_o 1 / Viscosidade do Óleo (1/cPoise).
+     * @param inversoMu_w 1 / Viscosidade da Água (1/cPoise).
+     * @param fw Saída: fw.
+     * @param dfw Saída: dfw/dSw.
+     */
+    static void fwDerivada(double krw, double kro, double dkrw, double dkro, double inversoMu_o, double inversoMu_w,
+                           double& fw, double& dfw) {
+        double lambda_w = krw * inversoMu_w;
+        double lambda_o = kro * inversoMu_o;
+        double lambda_t = lambda_w + lambda_o;
+
+        // Mesma checagem de divisão por zero de fw()
+        bool nula = lambda_t < std::numeric_limits<double>::epsilon();
+        double divisor = nula ? 1.0 : lambda_t;
+
+        // Derivadas das mobilidades em relação a Sw (regra do quociente)
+        double dlambda_w = dkrw * inversoMu_w;
+        double dlambda_o = dkro * inversoMu_o;
+        double f = lambda_w / divisor;
+        double df = (dlambda_w * lambda_o - lambda_w * dlambda_o) / (divisor * divisor);
+        fw = nula ? 0.0 : f;
+        dfw = nula ? 0.0 : df;
+    }
+};
+
+/**
+ * @struct ParViscosidades
+ * @brief Um par de viscosidades de uma curva de fw.
+ */
+struct ParViscosidades {
+    /// Viscosidade do Óleo (cPoise)
+    double mu_o;
+
+    /// Viscosidade da Água (cPoise)
+    double mu_w;
+};
+
+/**
+ * @struct KrNaMalha
+ * @brief Krw e Kro (e suas derivadas) numa malha de Sw, avaliados uma única vez.
+ *
+ * Kr só depende de Sw. Para estudar a sensibilidade às viscosidades, o
+ * modelo é avaliado uma vez na malha (CalculadoraFluxoFracionario::avaliarKrNaMalha)
+ * e cada par (mu_o, mu_w) vira uma curva de fw por um laço simples sobre
+ * estes vetores, sem chamar o modelo de novo. As curvas são idênticas às
+ * de uma calculadora construída com o mesmo par.
+ */
+struct KrNaMalha {
+    /// Saturações da malha.
+    std::vector<double> sw;
+
+    /// Krw em cada Sw.
+    std::vector<double> krw;
+
+    /// Kro em cada Sw.
+    std::vector<double> kro;
+
+    /// dKrw/dSw em cada Sw (vazio se a malha foi avaliada sem derivadas).
+    std::vector<double> dkrw;
+
+    /// dKro/dSw em cada Sw (vazio se a malha foi avaliada sem derivadas).
+    std::vector<double> dkro;
+
+    /// Indica se as derivadas foram avaliadas (curvas com a coluna dfw/dSw).
+    bool temDerivada() const { return !dkrw.empty(); }
+
+    /**
+     * @brief fw na malha para um par de viscosidades, num vetor do chamador.
+     * Sem alocação: para reaproveitar a mesma curva entre vários pares.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param fw Vetor de saída (sw.size() valores).
+     */
+    void fwNaMalha(double mu_o, double mu_w, double* fw) const {
+        if (mu_o <= 0 || mu_w <= 0) {
+            throw std::runtime_error("Erro: Viscosidades devem ser positivas.");
+        }
+        const double inversoMu_o = 1.0 / mu_o;
+        const double inversoMu_w = 1.0 / mu_w;
+
+        // Laço sobre vetores contíguos, sem chamadas ao modelo: vetorizável
+        const double* w = krw.data();
+        const double* o = kro.data();
+        const std::size_t n = sw.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            fw[i] = EquacaoFluxoFracionario::fw(w[i], o[i], inversoMu_o, inversoMu_w);
+        }
+    }
+
+    /**
+     * @brief fw e dfw/dSw na malha para um par de viscosidades (só com derivadas).
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param fw Vetor de saída para fw (sw.size() valores).
+     * @param dfw Vetor de saída para dfw/dSw (sw.size() valores).
+     */
+    void fwDerivadaNaMalha(double mu_o, double mu_w, double* fw, double* dfw) const {
+        if (mu_o <= 0 || mu_w <= 0) {
+            throw std::runtime_error("Erro: Viscosidades devem ser positivas.");
+        }
+        if (!temDerivada()) {
+            throw std::runtime_error("Erro: Kr na malha foi avaliado sem as derivadas.");
+        }
+        const double inversoMu_o = 1.0 / mu_o;
+        const double inversoMu_w = 1.0 / mu_w;
+        const double* w = krw.data();
+        const double* o = kro.data();
+        const double* dw = dkrw.data();
+        const double* dOleo = dkro.data();
+        const std::size_t n = sw.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            EquacaoFluxoFracionario::fwDerivada(w[i], o[i], dw[i], dOleo[i], inversoMu_o, inversoMu_w, fw[i], dfw[i]);
+        }
+    }
+
+    /**
+     * @brief Curva de fw (e dfw/dSw, se houver derivadas) para um par de viscosidades.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @return A curva na malha de sw.
+     */
+    CurvaFluxoFracionario curvaFw(double mu_o, double mu_w) const {
+        CurvaFluxoFracionario curva(sw.size(), temDerivada());
+        if (temDerivada()) {
+            fwDerivadaNaMalha(mu_o, mu_w, curva.fw().data(), curva.dfw().data());
+        } else {
+            fwNaMalha(mu_o, mu_w, curva.fw().data());
+        }
+        curva.sw() = sw;
+        return curva;
+    }
+};
+
+/**
+ * @class CalculadoraFluxoFracionarioEspecializada
+ * @brief Calculadora de Buckley-Leverett especializada, em tempo de compilação,
+ * para um tipo concreto de modelo de Kr.
+ *
+ * Com ModeloKr = CurvasPermeabilidadeCorey ou CurvasPermeabilidadeTabelada
+ * (classes final), as chamadas ao modelo não passam pela tabela virtual: o
+ * cálculo de um ponto (calcularKrPonto + fórmula de fw) é todo expandido
+ * em linha, e os lotes são processados em blocos pequenos na pilha, com a
+ * fórmula de fw aplicada logo em seguida, enquanto Krw e Kro ainda estão
+ * na cache L1. Com ModeloKr = ICurvasPermeabilidade obtém-se a versão
+ * genérica, com despacho virtual, para modelos sem especialização.
+ *
+ * CalculadoraFluxoFracionario é o adaptador polimórfico que escolhe a
+ * especialização uma única vez, no construtor.
+ *
+ * @tparam ModeloKr Tipo do modelo; deve oferecer calcularKrPonto,
+ * calcularKrLote e calcularKrDerivadaLote.
+ */
+template <typename ModeloKr>
+class CalculadoraFluxoFracionarioEspecializada {
+private:
+    /// Pontos por bloco nos cálculos em lote (Krw, Kro e derivadas cabem na L1).
+    static constexpr std::size_t PONTOS_POR_BLOCO = 256;
+
+    /// Intervalos da malha grossa inicial da amostragem adaptativa.
+    static constexpr std::size_t INTERVALOS_INICIAIS_ADAPTATIVA = 32;
+
+    /// Fator sobre o maior desvio medido em 1/4, 1/2 e 3/4 de um intervalo.
+    static constexpr double FATOR_SEGURANCA_ADAPTATIVA = 4.0 / 3.0;
+
+    /// 1 / Viscosidade do Óleo (calculado uma vez, no construtor)
+    double _inversoMu_o;
+
+    /// 1 / Viscosidade da Água
+    double _inversoMu_w;
+
+    /// Modelo de Kr (tipo concreto conhecido em tempo de compilação)
+    const ModeloKr* _modeloKr;
+
+public:
+    /**
+     * @brief Construtor.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param modelo O modelo de Kr (deve viver mais que a calculadora).
+     */
+    CalculadoraFluxoFracionarioEspecializada(double mu_o, double mu_w, const ModeloKr& modelo)
+    : _inversoMu_o(1.0 / mu_o), _inversoMu_w(1.0 / mu_w), _modeloKr(&modelo) {
+        if (mu_o <= 0 || mu_w <= 0) {
+            throw std::runtime_error("Erro: Viscosidades devem ser positivas.");
+        }
+    }
+
+    /**
+     * @brief Aplica a equação de Buckley-Leverett a um par (Krw, Kro),
+     * com as viscosidades da calculadora (ver EquacaoFluxoFracionario).
+     * @param krw Permeabilidade relativa da água.
+     * @param kro Permeabilidade relativa do óleo.
+     * @return O valor do fluxo fracionário (fw).
+     */
+    double fwDeKr(double krw, double kro) const {
+        return EquacaoFluxoFracionario::fw(krw, kro, _inversoMu_o, _inversoMu_w);
+    }
+
+    /**
+     * @brief Calcula um único ponto da curva de fluxo fracionário.
+     * @param sw A saturação de água.
+     * @return O valor do fluxo fracionário (fw).
+     */
+    double calcularFw(double sw) const {
+        double krw, kro;
+        _modeloKr->calcularKrPonto(sw, krw, kro);
+        return fwDeKr(krw, kro);
+    }
+
+    /**
+     * @brief Calcula o fluxo fracionário para um lote de saturações.
+     * @param sw Vetor de entrada com as saturações de água (n valores).
+     * @param fw Vetor de saída para os valores de fw (n valores).
+     * @param n Número de saturações do lote.
+     */
+    void calcularFwLote(const double* sw, double* fw, std::size_t n) const {
+        double krw[PONTOS_POR_BLOCO], kro[PONTOS_POR_BLOCO];
+        for (std::size_t inicio = 0; inicio < n; inicio += PONTOS_POR_BLOCO) {
+            std::size_t m = std::min(PONTOS_POR_BLOCO, n - inicio);
+            _modeloKr->calcularKrLote(sw + inicio, krw, kro, m);
+            for (std::size_t i = 0; i < m; ++i) {
+                fw[inicio + i] = fwDeKr(krw[i], kro[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Calcula fw e dfw/dSw para um lote de saturações.
+     * dfw/dSw = (Lambda_w' * Lambda_o - Lambda_w * Lambda_o') / Lambda_t^2.
+     * @param sw Vetor de entrada com as saturações de água (n valores).
+     * @param fw Vetor de saída para fw.
+     * @param dfw Vetor de saída para dfw/dSw.
+     * @param n Número de saturações do lote.
+     */
+    void calcularFwDerivadaLote(const double* sw, double* fw, double* dfw, std::size_t n) const {
+        double krw[PONTOS_POR_BLOCO], kro[PONTOS_POR_BLOCO], dkrw[PONTOS_POR_BLOCO], dkro[PONTOS_POR_BLOCO];
+        for (std::size_t inicio = 0; inicio < n; inicio += PONTOS_POR_BLOCO) {
+            std::size_t m = std::min(PONTOS_POR_BLOCO, n - inicio);
+            _modeloKr->calcularKrDerivadaLote(sw + inicio, krw, kro, dkrw, dkro, m);
+            for (std::size_t i = 0; i < m; ++i) {
+                EquacaoFluxoFracionario::fwDerivada(krw[i], kro[i], dkrw[i], dkro[i], _inversoMu_o,
+                                                    _inversoMu_w, fw[inicio + i], dfw[inicio + i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Monta a malha uniforme de saturações de uma curva.
+     * Malha de CurvaFluxoFracionario::malhaUniforme (Sw_i = i * passo, terminando em 1.0).
+     * @param passo O incremento de Saturação.
+     * @param comDerivada Se a curva deve reservar a coluna dfw/dSw.
+     * @return Curva com Sw preenchido e Fw (e dfw) a calcular.
+     */
+    static CurvaFluxoFracionario montarMalha(double passo, bool comDerivada) {
+        return CurvaFluxoFracionario(CurvaFluxoFracionario::malhaUniforme(passo), comDerivada);
+    }
+
+    /**
+     * @brief Gera a curva completa de Fw vs Sw.
+     * @param passo O incremento de Saturação (ex: 0.01 para 1%).
+     * @return A curva (Sw, Fw) em vetores contíguos.
+     */
+    CurvaFluxoFracionario gerarCurvaCompleta(double passo) const {
+        CurvaFluxoFracionario curva = montarMalha(passo, false);
+        calcularFwLote(curva.sw().data(), curva.fw().data(), curva.tamanho());
+        return curva;
+    }
+
+    /**
+     * @brief Gera a curva Fw vs Sw já com a coluna dfw/dSw.
+     * @param passo O incremento de Saturação.
+     * @return A curva (Sw, Fw, dfw/dSw) em vetores contíguos.
+     */
+    CurvaFluxoFracionario gerarCurvaComDerivada(double passo) const {
+        CurvaFluxoFracionario curva = montarMalha(passo, true);
+        calcularFwDerivadaLote(curva.sw().data(), curva.fw().data(), curva.dfw().data(), curva.tamanho());
+        return curva;
+    }
+
+    /**
+     * @brief Avalia Krw e Kro (e as derivadas) uma única vez na malha uniforme.
+     * As viscosidades da calculadora não entram: o resultado serve para
+     * qualquer par (ver KrNaMalha::curvaFw).
+     * @param passo O incremento de Saturação.
+     * @param comDerivada Se também avalia dKrw/dSw e dKro/dSw.
+     * @return Kr na malha de gerarCurvaCompleta(passo).
+     */
+    KrNaMalha avaliarKrNaMalha(double passo, bool comDerivada) const {
+        KrNaMalha kr;
+        kr.sw = CurvaFluxoFracionario::malhaUniforme(passo);
+        const std::size_t n = kr.sw.size();
+        kr.krw.resize(n);
+        kr.kro.resize(n);
+        if (!comDerivada) {
+            _modeloKr->calcularKrLote(kr.sw.data(), kr.krw.data(), kr.kro.data(), n);
+            return kr;
+        }
+        kr.dkrw.resize(n);
+        kr.dkro.resize(n);
+        _modeloKr->calcularKrDerivadaLote(kr.sw.data(), kr.krw.data(), kr.kro.data(), kr.dkrw.data(), kr.dkro.data(), n);
+        return kr;
+    }
+
+    /**
+     * @brief Gera as curvas de fw de vários pares de viscosidades com um só cálculo de Kr.
+     * @param passo O incremento de Saturação.
+     * @param pares Os pares (mu_o, mu_w).
+     * @param comDerivada Se as curvas devem trazer a coluna dfw/dSw.
+     * @return Uma curva por par, na ordem de pares.
+     */
+    std::vector<CurvaFluxoFracionario> gerarCurvasViscosidades(double passo, const std::vector<ParViscosidades>& pares,
+                                                               bool comDerivada) const {
+        const KrNaMalha kr = avaliarKrNaMalha(passo, comDerivada);
+        std::vector<CurvaFluxoFracionario> curvas;
+        curvas.reserve(pares.size());
+        for (const ParViscosidades& par : pares) {
+            curvas.push_back(kr.curvaFw(par.mu_o, par.mu_w));
+        }
+        return curvas;
+    }
+
+    /**
+     * @brief Gera a curva Fw vs Sw com amostragem adaptativa.
+     *
+     * Parte de uma malha grossa uniforme mais os pontos de quebra do modelo
+     * (Swir e 1 - Sorw no Corey, as linhas da tabela no tabelado), que ficam
+     * na curva exatamente. Cada intervalo é testado em 1/4, 1/2 e 3/4 (só o
+     * ponto médio deixaria passar intervalos com a inflexão de fw, onde o
+     * desvio muda de sinal): se o maior desvio entre fw e a corda (erro da
+     * interpolação linear, proporcional à curvatura vezes h^2), vezes 4/3,
+     * passar da tolerância, os três pontos entram na curva e os quatro
+     * subintervalos são testados de novo. O fator 4/3 cobre o pico do erro
+     * entre os pontos testados. Os pontos de cada nível são calculados num
+     * único lote. Trechos retos (fw = 0 abaixo de Swir, fw = 1 acima de
+     * 1 - Sorw) não recebem pontos extras.
+     * @param tolerancia Erro máximo de interpolação linear de fw (> 0).
+     * @param comDerivada Se a curva deve trazer a coluna dfw/dSw.
+     * @param passoMinimo Menor largura de intervalo (limita o refinamento).
+     * @return A curva em ordem crescente de Sw.
+     */
+    CurvaFluxoFracionario gerarCurvaAdaptativa(double tolerancia, bool comDerivada, double passoMinimo = 1e-6) const {
+        if (!(tolerancia > 0.0) || !(passoMinimo > 0.0)) {
+            throw std::runtime_error("Erro: Tolerancia e passo minimo da curva adaptativa devem ser positivos.");
+        }
+
+        // 1. Nós obrigatórios: malha grossa (com 0 e 1) e pontos de quebra em (0, 1)
+        std::vector<double> sw;
+        for (std::size_t i = 0; i < INTERVALOS_INICIAIS_ADAPTATIVA; ++i) {
+            sw.push_back(static_cast<double>(i) / static_cast<double>(INTERVALOS_INICIAIS_ADAPTATIVA));
+        }
+        sw.push_back(1.0);
+        for (double q : _modeloKr->pontosDeQuebra()) {
+            if (q > 0.0 && q < 1.0) {
+                sw.push_back(q);
+            }
+        }
+        std::sort(sw.begin(), sw.end());
+        sw.erase(std::unique(sw.begin(), sw.end()), sw.end());
+
+        std::vector<double> fw(sw.size());
+        calcularFwLote(sw.data(), fw.data(), sw.size());
+
+        // 2. Refinamento por níveis: intervalos (índices dos extremos em sw/fw)
+        std::vector<std::pair<std::size_t, std::size_t>> pendentes, proximos;
+        for (std::size_t i = 0; i + 1 < sw.size(); ++i) {
+            pendentes.emplace_back(i, i + 1);
+        }
+        std::vector<double> swTeste, fwTeste;
+        while (!pendentes.empty()) {
+            // Intervalos que não cabem em 4 passos mínimos não são divididos
+            std::size_t m = 0;
+            for (const auto& [a, b] : pendentes) {
+                if (sw[b] - sw[a] > 4.0 * passoMinimo) {
+                    pendentes[m++] = {a, b};
+                }
+            }
+            pendentes.resize(m);
+
+            // fw em 1/4, 1/2 e 3/4 de cada intervalo, num único lote
+            swTeste.resize(3 * m);
+            fwTeste.resize(3 * m);
+            for (std::size_t k = 0; k < m; ++k) {
+                double a = sw[pendentes[k].first], b = sw[pendentes[k].second];
+                swTeste[3 * k] = a + 0.25 * (b - a);
+                swTeste[3 * k + 1] = 0.5 * (a + b);
+                swTeste[3 * k + 2] = a + 0.75 * (b - a);
+            }
+            calcularFwLote(swTeste.data(), fwTeste.data(), 3 * m);
+
+            proximos.clear();
+            for (std::size_t k = 0; k < m; ++k) {
+                auto [a, b] = pendentes[k];
+                double desvio = std::max({std::fabs(fwTeste[3 * k] - (0.75 * fw[a] + 0.25 * fw[b])),
+                                          std::fabs(fwTeste[3 * k + 1] - 0.5 * (fw[a] + fw[b])),
+                                          std::fabs(fwTeste[3 * k + 2] - (0.25 * fw[a] + 0.75 * fw[b]))});
+                if (FATOR_SEGURANCA_ADAPTATIVA * desvio <= tolerancia) {
+                    continue; // a corda já representa o intervalo
+                }
+
+                // Os três pontos já calculados entram na curva: quatro subintervalos
+                std::size_t primeiro = sw.size();
+                for (std::size_t j = 0; j < 3; ++j) {
+                    sw.push_back(swTeste[3 * k + j]);
+                    fw.push_back(fwTeste[3 * k + j]);
+                }
+                proximos.emplace_back(a, primeiro);
+                proximos.emplace_back(primeiro, primeiro + 1);
+                proximos.emplace_back(primeiro + 1, primeiro + 2);
+                proximos.emplace_back(primeiro + 2, b);
+            }
+            pendentes.swap(proximos);
+        }
+
+        // 3. Curva em ordem crescente de Sw
+        std::vector<std::size_t> ordem(sw.size());
+        std::iota(ordem.begin(), ordem.end(), 0);
+        std::sort(ordem.begin(), ordem.end(), [&sw](std::size_t a, std::size_t b) { return sw[a] < sw[b]; });
+
+        CurvaFluxoFracionario curva(sw.size(), comDerivada);
+        for (std::size_t i = 0; i < ordem.size(); ++i) {
+            curva.sw()[i] = sw[ordem[i]];
+            curva.fw()[i] = fw[ordem[i]];
+        }
+        if (comDerivada) {
+            calcularFwDerivadaLote(curva.sw().data(), curva.fw().data(), curva.dfw().data(), curva.tamanho());
+        }
+        return curva;
+    }
+};
+
+#endif
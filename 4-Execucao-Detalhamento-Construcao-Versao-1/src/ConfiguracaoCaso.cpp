@@ -0,0 +1,460 @@
+#include "ConfiguracaoCaso.h"
+#include <charconv>  // Para std::from_chars
+#include <cmath>     // Para std::floor
+#include <cstring>   // Para std::memchr
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>   // Para std::move
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CONFIGURACAO_POSIX 1
+#endif
+
+namespace {
+
+/// Arquivos a partir deste tamanho são mapeados em memória; os menores são lidos de uma vez
+/// (para decks de poucas linhas o mmap/munmap custa mais que um read).
+const std::size_t LIMIAR_MAPEAMENTO = 64 * 1024;
+
+/// Parâmetros que podem ser variados na varredura ou no Monte Carlo.
+const char* const PARAMETROS_VARIAVEIS[] = {
+    "VISC_OLEO", "VISC_AGUA", "COREY_SWIR", "COREY_SORW",
+    "COREY_KRW_MAX", "COREY_KRO_MAX", "COREY_NW", "COREY_NO"
+};
+
+/**
+ * @class CursorLinha
+ * @brief Percorre os tokens de uma linha, separados por espaços, até o fim ou um '#'.
+ */
+class CursorLinha {
+private:
+    const char* _p;
+    const char* _fim;
+
+public:
+    CursorLinha(const char* inicio, const char* fim) : _p(inicio), _fim(fim) {}
+
+    /**
+     * @brief Extrai o próximo token.
+     * @param token Recebe o token (sem cópia).
+     * @return false no fim da linha ou no início de um comentário.
+     */
+    bool proximo(std::string_view& token) {
+        while (_p < _fim && (*_p == ' ' || *_p == '\t' || *_p == '\r')) {
+            ++_p;
+        }
+        if (_p == _fim || *_p == '#') {
+            return false;
+        }
+        const char* inicio = _p;
+        while (_p < _fim && *_p != ' ' && *_p != '\t' && *_p != '\r' && *_p != '#') {
+            ++_p;
+        }
+        token = std::string_view(inicio, static_cast<std::size_t>(_p - inicio));
+        return true;
+    }
+};
+
+/**
+ * @brief Monta a mensagem de erro com a posição no arquivo.
+ */
+std::runtime_error erroNaLinha(const std::string& mensagem, std::size_t numeroLinha, const std::string& arquivo) {
+    return std::runtime_error("Erro: " + mensagem + " (linha " + std::to_string(numeroLinha) + " de " + arquivo + ").");
+}
+
+/**
+ * @brief Converte um token em número (real ou inteiro) com std::from_chars.
+ * @return false se o token não for inteiramente um número.
+ */
+template <typename T>
+bool converter(std::string_view token, T& valor) {
+    // from_chars não aceita o sinal '+', que o operator>> aceitava
+    if (!token.empty() && token.front() == '+') {
+        token.remove_prefix(1);
+    }
+    const char* fim = token.data() + token.size();
+    auto [ptr, ec] = std::from_chars(token.data(), fim, valor);
+    return ec == std::errc() && ptr == fim;
+}
+
+/**
+ * @brief Lê o próximo token da linha como número; erro se ausente ou inválido.
+ */
+template <typename T>
+T lerNumero(CursorLinha& cursor, std::string_view palavraChave, std::size_t numeroLinha, const std::string& arquivo) {
+    std::string_view token;
+    if (!cursor.proximo(token)) {
+        throw erroNaLinha("Valor ausente para " + std::string(palavraChave), numeroLinha, arquivo);
+    }
+    T valor{};
+    if (!converter(token, valor)) {
+        throw erroNaLinha("Valor invalido '" + std::string(token) + "' para " + std::string(palavraChave),
+                          numeroLinha, arquivo);
+    }
+    return valor;
+}
+
+/**
+ * @brief Indica se o nome é de um parâmetro que pode ser variado.
+ */
+bool parametroVariavel(std::string_view nome) {
+    for (const char* valido : PARAMETROS_VARIAVEIS) {
+        if (nome == valido) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Interpreta o restante de uma linha VARREDURA: "PARAMETRO v1 v2 ..." ou "PARAMETRO inicio:fim:passo".
+ */
+EixoVarredura lerEixo(CursorLinha& cursor, std::size_t numeroLinha, const std::string& arquivo) {
+    std::string_view token;
+    if (!cursor.proximo(token)) {
+        throw erroNaLinha("VARREDURA sem parametro", numeroLinha, arquivo);
+    }
+
+    EixoVarredura eixo;
+    eixo.parametro = std::string(token);
+    if (!parametroVariavel(token)) {
+        throw erroNaLinha("Parametro de VARREDURA nao reconhecido: " + eixo.parametro, numeroLinha, arquivo);
+    }
+
+    while (cursor.proximo(token)) {
+        std::size_t p1 = token.find(':');
+        if (p1 == std::string_view::npos) {
+            double valor;
+            if (!converter(token, valor)) {
+                throw erroNaLinha("Valor invalido '" + std::string(token) + "' em VARREDURA", numeroLinha, arquivo);
+            }
+            eixo.valores.push_back(valor);
+            continue;
+        }
+
+        // Faixa inicio:fim:passo, gerada por índice inteiro (inclui o fim)
+        std::size_t p2 = token.find(':', p1 + 1);
+        double inicio, fim, passo;
+        if (p2 == std::string_view::npos
+            || !converter(token.substr(0, p1), inicio)
+            || !converter(token.substr(p1 + 1, p2 - p1 - 1), fim)
+            || !converter(token.substr(p2 + 1), passo)) {
+            throw erroNaLinha("Faixa de VARREDURA deve ser inicio:fim:passo: " + std::string(token), numeroLinha, arquivo);
+        }
+        if (passo <= 0 || fim < inicio) {
+            throw erroNaLinha("Faixa de VARREDURA invalida: " + std::string(token), numeroLinha, arquivo);
+        }
+        std::size_t n = static_cast<std::size_t>(std::floor((fim - inicio) / passo + 1e-9));
+        for (std::size_t i = 0; i <= n; ++i) {
+            eixo.valores.push_back(inicio + static_cast<double>(i) * passo);
+        }
+    }
+
+    if (eixo.valores.empty()) {
+        throw erroNaLinha("VARREDURA " + eixo.parametro + " sem valores", numeroLinha, arquivo);
+    }
+    return eixo;
+}
+
+/**
+ * @brief Interpreta o restante de uma linha MC_DISTRIBUICAO: "PARAMETRO TIPO a b [c]".
+ */
+DistribuicaoParametro lerDistribuicao(CursorLinha& cursor, std::size_t numeroLinha, const std::string& arquivo) {
+    DistribuicaoParametro d;
+    std::string_view token;
+    if (!cursor.proximo(token) || !parametroVariavel(token)) {
+        throw erroNaLinha("Parametro de MC_DISTRIBUICAO ausente ou nao reconhecido", numeroLinha, arquivo);
+    }
+    d.parametro = std::string(token);
+
+    if (!cursor.proximo(token)) {
+        throw erroNaLinha("Tipo de distribuicao ausente para " + d.parametro, numeroLinha, arquivo);
+    }
+    if (token == "UNIFORME")        d.tipo = DistribuicaoParametro::Tipo::Uniforme;
+    else if (token == "TRIANGULAR") d.tipo = DistribuicaoParametro::Tipo::Triangular;
+    else if (token == "NORMAL")     d.tipo = DistribuicaoParametro::Tipo::Normal;
+    else if (token == "LOGNORMAL")  d.tipo = DistribuicaoParametro::Tipo::LogNormal;
+    else {
+        throw erroNaLinha("Distribuicao nao reconhecida: " + std::string(token)
+                          + ". Use UNIFORME, TRIANGULAR, NORMAL ou LOGNORMAL", numeroLinha, arquivo);
+    }
+
+    d.a = lerNumero<double>(cursor, "MC_DISTRIBUICAO", numeroLinha, arquivo);
+    d.b = lerNumero<double>(cursor, "MC_DISTRIBUICAO", numeroLinha, arquivo);
+    if (d.tipo == DistribuicaoParametro::Tipo::Triangular) {
+        d.c = lerNumero<double>(cursor, "MC_DISTRIBUICAO", numeroLinha, arquivo);
+    }
+
+    // Consistência dos argumentos (a triangular é minimo, moda, maximo)
+    bool valida = true;
+    switch (d.tipo) {
+        case DistribuicaoParametro::Tipo::Uniforme:   valida = d.a <= d.b; break;
+        case DistribuicaoParametro::Tipo::Triangular: valida = d.a <= d.b && d.b <= d.c && d.a < d.c; break;
+        case DistribuicaoParametro::Tipo::Normal:
+        case DistribuicaoParametro::Tipo::LogNormal:  valida = d.b >= 0.0; break;
+    }
+    if (!valida) {
+        throw erroNaLinha("Argumentos invalidos na distribuicao de " + d.parametro, numeroLinha, arquivo);
+    }
+    return d;
+}
+
+} // namespace
+
+/**
+ * @brief Lê o arquivo de uma vez (ou o mapeia em memória) e o interpreta.
+ * @param arquivo O caminho do arquivo de entrada.
+ * @return A configuração do caso.
+ */
+ConfiguracaoCaso ConfiguracaoCaso::lerArquivo(const std::string& arquivo) {
+#ifdef CONFIGURACAO_POSIX
+    int fd = ::open(arquivo.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || ::fstat(fd, &info) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw std::runtime_error("Erro: Nao foi possivel abrir o arquivo: " + arquivo);
+    }
+    std::size_t tamanho = static_cast<std::size_t>(info.st_size);
+
+    // 1. Arquivos grandes: mapeamento em memória, sem cópia
+    if (tamanho >= LIMIAR_MAPEAMENTO) {
+        void* mapa = ::mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapa == MAP_FAILED) {
+            throw std::runtime_error("Erro: Nao foi possivel mapear o arquivo: " + arquivo);
+        }
+        ::madvise(mapa, tamanho, MADV_SEQUENTIAL);
+        try {
+            ConfiguracaoCaso cfg = interpretar(std::string_view(static_cast<const char*>(mapa), tamanho), arquivo);
+            ::munmap(mapa, tamanho);
+            return cfg;
+        } catch (...) {
+            ::munmap(mapa, tamanho);
+            throw;
+        }
+    }
+
+    // 2. Arquivos pequenos: uma leitura para um buffer do tamanho exato
+    std::string conteudo(tamanho, '\0');
+    std::size_t lidos = 0;
+    while (lidos < tamanho) {
+        ssize_t r = ::read(fd, &conteudo[lidos], tamanho - lidos);
+        if (r <= 0) {
+            break;
+        }
+        lidos += static_cast<std::size_t>(r);
+    }
+    ::close(fd);
+    conteudo.resize(lidos);
+    return interpretar(conteudo, arquivo);
+#else
+    std::ifstream arq(arquivo, std::ios::binary);
+    if (!arq.is_open()) {
+        throw std::runtime_error("Erro: Nao foi possivel abrir o arquivo: " + arquivo);
+    }
+    std::string conteudo((std::istreambuf_iterator<char>(arq)), std::istreambuf_iterator<char>());
+    return interpretar(conteudo, arquivo);
+#endif
+}
+
+/**
+ * @brief Interpreta o conteúdo do arquivo numa única passada.
+ * @param texto O conteúdo do arquivo.
+ * @param arquivo Nome de origem (para mensagens).
+ * @return A configuração do caso.
+ */
+ConfiguracaoCaso ConfiguracaoCaso::interpretar(std::string_view texto, const std::string& arquivo) {
+    ConfiguracaoCaso cfg;
+    cfg._arquivo = arquivo;
+
+    bool lendoDados = false;
+    TabelaKr* tabelaAtual = &cfg._tabela; // Bloco sem região: a tabela principal
+    std::size_t numeroLinha = 0;
+    const char* p = texto.data();
+    const char* fimTexto = p + texto.size();
+
+    while (p < fimTexto) {
+        // 1. Delimitar a linha (sem copiar)
+        const char* fimLinha = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(fimTexto - p)));
+        if (fimLinha == nullptr) {
+            fimLinha = fimTexto;
+        }
+        CursorLinha cursor(p, fimLinha);
+        p = fimLinha + 1;
+        ++numeroLinha;
+
+        // 2. Linhas vazias e comentários não têm token
+        std::string_view chave;
+        if (!cursor.proximo(chave)) {
+            continue;
+        }
+
+        // 3. Linhas do bloco de dados começam por um número
+        char c = chave.front();
+        if (lendoDados && ((c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+')) {
+            double valores[3];
+            if (!converter(chave, valores[0])) {
+                throw erroNaLinha("Valor invalido '" + std::string(chave) + "' na tabela de Kr", numeroLinha, arquivo);
+            }
+            valores[1] = lerNumero<double>(cursor, "Krw", numeroLinha, arquivo);
+            valores[2] = lerNumero<double>(cursor, "Kro", numeroLinha, arquivo);
+            tabelaAtual->sw.push_back(valores[0]);
+            tabelaAtual->krw.push_back(valores[1]);
+            tabelaAtual->kro.push_back(valores[2]);
+            continue;
+        }
+
+        // 4. Palavras-chave
+        if (chave == "VISC_OLEO") {
+            cfg._mu_o = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "VISC_AGUA") {
+            cfg._mu_w = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "MODELO_KR") {
+            std::string_view tipo;
+            if (cursor.proximo(tipo)) {
+                cfg._tipoModelo = std::string(tipo);
+            }
+        } else if (chave == "DADOS_KR_INICIO") {
+            // Número da região opcional: cada região tem sua própria tabela
+            std::string_view token;
+            tabelaAtual = &cfg._tabela;
+            if (cursor.proximo(token)) {
+                TabelaKrRegiao regiao;
+                if (!converter(token, regiao.regiao)) {
+                    throw erroNaLinha("Regiao invalida '" + std::string(token) + "' em DADOS_KR_INICIO", numeroLinha, arquivo);
+                }
+                for (const TabelaKrRegiao& r : cfg._tabelasRegioes) {
+                    if (r.regiao == regiao.regiao) {
+                        throw erroNaLinha("Regiao de Kr " + std::string(token) + " repetida", numeroLinha, arquivo);
+                    }
+                }
+                cfg._tabelasRegioes.push_back(std::move(regiao));
+                tabelaAtual = &cfg._tabelasRegioes.back().tabela;
+            }
+            lendoDados = true;
+        } else if (chave == "FIM_DADOS") {
+            lendoDados = false;
+        } else if (chave == "INDICE_UNIFORME_KR") {
+            cfg._tabela.indiceUniforme = lerNumero<std::size_t>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "INTERPOLACAO_KR") {
+            std::string_view modo;
+            cursor.proximo(modo);
+            if (modo == "LINEAR")     cfg._tabela.interpolacao = InterpolacaoKr::Linear;
+            else if (modo == "PCHIP") cfg._tabela.interpolacao = InterpolacaoKr::Pchip;
+            else {
+                throw erroNaLinha("INTERPOLACAO_KR nao reconhecida: '" + std::string(modo)
+                                  + "'. Use LINEAR ou PCHIP", numeroLinha, arquivo);
+            }
+        } else if (chave == "COREY_SWIR") {
+            cfg._corey.swir = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "COREY_SORW") {
+            cfg._corey.sorw = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "COREY_KRW_MAX") {
+            cfg._corey.krw_max = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "COREY_KRO_MAX") {
+            cfg._corey.kro_max = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "COREY_NW") {
+            cfg._corey.nw = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "COREY_NO") {
+            cfg._corey.no = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "SW_INICIAL") {
+            cfg._swInicial = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "PASSO_SW") {
+            cfg._passo = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "TOLERANCIA_CURVA") {
+            cfg._toleranciaCurva = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "NUM_THREADS") {
+            cfg._numeroThreads = lerNumero<std::size_t>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "NUM_CELULAS") {
+            cfg._deslocamento.numeroCelulas = lerNumero<std::size_t>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "COMPRIMENTO") {
+            cfg._deslocamento.comprimento = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "AREA_SECAO") {
+            cfg._deslocamento.areaSecao = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "POROSIDADE") {
+            cfg._deslocamento.porosidade = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "VAZAO_INJECAO") {
+            cfg._deslocamento.vazaoInjecao = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+            cfg._temVazao = true;
+        } else if (chave == "CFL") {
+            cfg._deslocamento.cfl = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "TEMPOS_SAIDA") {
+            std::string_view token;
+            while (cursor.proximo(token)) {
+                double t;
+                if (!converter(token, t)) {
+                    throw erroNaLinha("Valor invalido '" + std::string(token) + "' para TEMPOS_SAIDA", numeroLinha, arquivo);
+                }
+                if (!(t >= 0.0)) {
+                    throw erroNaLinha("TEMPOS_SAIDA nao aceita tempo negativo: '" + std::string(token) + "'",
+                                      numeroLinha, arquivo);
+                }
+                cfg._deslocamento.temposSaida.push_back(t);
+            }
+        } else if (chave == "VARREDURA") {
+            cfg._eixos.push_back(lerEixo(cursor, numeroLinha, arquivo));
+        } else if (chave == "SAIDA_GRAFICO") {
+            std::string_view modo;
+            cursor.proximo(modo);
+            if (modo == "JANELA")           cfg._saidaGrafico = SaidaGrafico::Janela;
+            else if (modo == "PNG")         cfg._saidaGrafico = SaidaGrafico::Png;
+            else if (modo == "SVG")         cfg._saidaGrafico = SaidaGrafico::Svg;
+            else if (modo == "SVG_INTERNO") cfg._saidaGrafico = SaidaGrafico::SvgInterno;
+            else if (modo == "NENHUM")      cfg._saidaGrafico = SaidaGrafico::Nenhuma;
+            else {
+                throw erroNaLinha("SAIDA_GRAFICO nao reconhecida: '" + std::string(modo)
+                                  + "'. Use JANELA, PNG, SVG, SVG_INTERNO ou NENHUM", numeroLinha, arquivo);
+            }
+        } else if (chave == "FORMATO_SAIDA") {
+            std::string_view formato;
+            cursor.proximo(formato);
+            if (formato == "CSV")          cfg._formatoSaida = FormatoSaida::Csv;
+            else if (formato == "BINARIO") cfg._formatoSaida = FormatoSaida::Binario;
+            else if (formato == "AMBOS")   cfg._formatoSaida = FormatoSaida::Ambos;
+            else {
+                throw erroNaLinha("FORMATO_SAIDA nao reconhecido: '" + std::string(formato)
+                                  + "'. Use CSV, BINARIO ou AMBOS", numeroLinha, arquivo);
+            }
+        } else if (chave == "AJUSTE_COREY") {
+            // Número de pontos iniciais opcional (padrão 32)
+            std::string_view token;
+            cfg._ajusteCoreyInicios = 32;
+            if (cursor.proximo(token) && !converter(token, cfg._ajusteCoreyInicios)) {
+                throw erroNaLinha("Valor invalido '" + std::string(token) + "' para AJUSTE_COREY", numeroLinha, arquivo);
+            }
+        } else if (chave == "MC_REALIZACOES") {
+            cfg._monteCarlo.realizacoes = lerNumero<std::size_t>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "MC_SEMENTE") {
+            cfg._monteCarlo.semente = lerNumero<std::uint64_t>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "MC_PVI_MAX") {
+            cfg._monteCarlo.pviMaximo = lerNumero<double>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "MC_BALDES") {
+            cfg._monteCarlo.baldes = lerNumero<std::size_t>(cursor, chave, numeroLinha, arquivo);
+        } else if (chave == "MC_DISTRIBUICAO") {
+            cfg._monteCarlo.distribuicoes.push_back(lerDistribuicao(cursor, numeroLinha, arquivo));
+        }
+        // Palavras-chave desconhecidas são ignoradas, como antes
+    }
+
+    // INDICE_UNIFORME_KR e INTERPOLACAO_KR valem para todas as regiões
+    for (TabelaKrRegiao& r : cfg._tabelasRegioes) {
+        r.tabela.indiceUniforme = cfg._tabela.indiceUniforme;
+        r.tabela.interpolacao = cfg._tabela.interpolacao;
+    }
+    // Só há tabelas por região: o caso principal usa a primeira
+    if (cfg._tabela.sw.empty() && !cfg._tabelasRegioes.empty()) {
+        const TabelaKr& primeira = cfg._tabelasRegioes.front().tabela;
+        cfg._tabela.sw = primeira.sw;
+        cfg._tabela.krw = primeira.krw;
+        cfg._tabela.kro = primeira.kro;
+    }
+
+    return cfg;
+}
@@ -0,0 +1,238 @@
+#ifndef CONFIGURACAOCASO_H
+#define CONFIGURACAOCASO_H
+
+#include "CurvasPermeabilidadeCorey.h"
+#include "CurvasPermeabilidadeTabelada.h"
+#include "TabelasKrRegioes.h"
+#include "SimuladorDeslocamento1D.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef> // Para std::size_t
+#include <cstdint> // Para std::uint64_t
+
+/**
+ * @struct EixoVarredura
+ * @brief Um parâmetro variado na varredura e a lista de seus valores.
+ */
+struct EixoVarredura {
+    /// Nome do parâmetro (VISC_OLEO, VISC_AGUA ou COREY_*).
+    std::string parametro;
+
+    /// Valores que o parâmetro assume.
+    std::vector<double> valores;
+};
+
+/**
+ * @brief Destino dos gráficos (palavra-chave SAIDA_GRAFICO).
+ */
+enum class SaidaGrafico {
+    Janela,     ///< JANELA: janela interativa do gnuplot (padrão)
+    Png,        ///< PNG: arquivo .png pelo gnuplot
+    Svg,        ///< SVG: arquivo .svg pelo gnuplot
+    SvgInterno, ///< SVG_INTERNO: arquivo .svg sem processo externo (GraficoSvg)
+    Nenhuma     ///< NENHUM: sem gráficos
+};
+
+/**
+ * @brief Formato dos arquivos de séries (palavra-chave FORMATO_SAIDA).
+ */
+enum class FormatoSaida {
+    Csv,     ///< CSV: texto (padrão)
+    Binario, ///< BINARIO: binário colunar (.bin, ver EscritorColunas)
+    Ambos    ///< AMBOS: os dois
+};
+
+/**
+ * @struct DistribuicaoParametro
+ * @brief Distribuição de probabilidade de um parâmetro incerto (linha MC_DISTRIBUICAO).
+ */
+struct DistribuicaoParametro {
+    /// Tipos de distribuição suportados.
+    enum class Tipo {
+        Uniforme,   ///< UNIFORME minimo maximo
+        Triangular, ///< TRIANGULAR minimo moda maximo
+        Normal,     ///< NORMAL media desvio
+        LogNormal   ///< LOGNORMAL media desvio (de ln X)
+    };
+
+    /// Nome do parâmetro (VISC_OLEO, VISC_AGUA ou COREY_*).
+    std::string parametro;
+
+    /// Tipo da distribuição.
+    Tipo tipo = Tipo::Uniforme;
+
+    /// Parâmetros da distribuição, na ordem da linha (o terceiro só na triangular).
+    double a = 0.0;
+    double b = 0.0;
+    double c = 0.0;
+};
+
+/**
+ * @struct ParametrosMonteCarlo
+ * @brief Dados do modo Monte Carlo (palavras-chave MC_*).
+ */
+struct ParametrosMonteCarlo {
+    /// Número de realizações (MC_REALIZACOES); 0 desativa o modo.
+    std::size_t realizacoes = 0;
+
+    /// Semente do gerador (MC_SEMENTE).
+    std::uint64_t semente = 20240101;
+
+    /// Volume poroso injetado máximo das curvas de recuperação (MC_PVI_MAX).
+    double pviMaximo = 3.0;
+
+    /// Número de baldes dos histogramas de quantis (MC_BALDES).
+    std::size_t baldes = 1000;
+
+    /// Parâmetros incertos; os demais ficam nos valores do arquivo.
+    std::vector<DistribuicaoParametro> distribuicoes;
+};
+
+/**
+ * @class ConfiguracaoCaso
+ * @brief Todos os dados de um arquivo de entrada, lidos numa única passada.
+ *
+ * O arquivo é lido uma só vez (mapeado em memória quando o sistema
+ * permite) e interpretado sem std::stringstream: as linhas são separadas
+ * em tokens por ponteiros e os números convertidos com std::from_chars.
+ * O objeto resultante é imutável (só tem métodos const) e contém tudo o que
+ * o Simulador e os modelos de Kr precisam, que passam a ser construídos a
+ * partir dele em vez de relerem o arquivo.
+ *
+ * Campos opcionais ausentes mantêm seus valores padrão; os parâmetros de
+ * Corey ausentes ficam em -1 e são rejeitados na construção do modelo.
+ */
+class ConfiguracaoCaso {
+private:
+    /// Arquivo de origem (para mensagens e nomes dos arquivos de saída).
+    std::string _arquivo;
+
+    /// Viscosidade do óleo (cPoise); -1 se ausente.
+    double _mu_o = -1.0;
+
+    /// Viscosidade da água (cPoise); -1 se ausente.
+    double _mu_w = -1.0;
+
+    /// Tipo do modelo de Kr (MODELO_KR).
+    std::string _tipoModelo;
+
+    /// Saturação inicial (SW_INICIAL); < 0 usa a água conata da curva.
+    double _swInicial = -1.0;
+
+    /// Passo de saturação das curvas (PASSO_SW).
+    double _passo = 0.01;
+
+    /// Tolerância da curva adaptativa (TOLERANCIA_CURVA); 0 = malha uniforme de PASSO_SW.
+    double _toleranciaCurva = 0.0;
+
+    /// Número de threads (NUM_THREADS); 0 = todos os núcleos.
+    std::size_t _numeroThreads = 0;
+
+    /// Indica se VAZAO_INJECAO foi informada.
+    bool _temVazao = false;
+
+    /// Parâmetros do deslocamento 1D (NUM_CELULAS, COMPRIMENTO, ...).
+    ParametrosDeslocamento1D _deslocamento;
+
+    /// Parâmetros de Corey (COREY_*); -1 nos ausentes.
+    ParametrosCorey _corey{-1.0, -1.0, -1.0, -1.0, -1.0, -1.0};
+
+    /// Tabela de Kr (bloco DADOS_KR_INICIO ... FIM_DADOS).
+    TabelaKr _tabela;
+
+    /// Tabelas de Kr por região (blocos DADOS_KR_INICIO <regiao>), na ordem do arquivo.
+    std::vector<TabelaKrRegiao> _tabelasRegioes;
+
+    /// Eixos da varredura (linhas VARREDURA).
+    std::vector<EixoVarredura> _eixos;
+
+    /// Modo Monte Carlo (palavras-chave MC_*).
+    ParametrosMonteCarlo _monteCarlo;
+
+    /// Pontos iniciais do ajuste de Corey (AJUSTE_COREY); 0 desativa o modo.
+    std::size_t _ajusteCoreyInicios = 0;
+
+    /// Destino dos gráficos (SAIDA_GRAFICO).
+    SaidaGrafico _saidaGrafico = SaidaGrafico::Janela;
+
+    /// Formato dos arquivos de séries (FORMATO_SAIDA).
+    FormatoSaida _formatoSaida = FormatoSaida::Csv;
+
+    /**
+     * @brief Construtor privado: use lerArquivo ou interpretar.
+     */
+    ConfiguracaoCaso() = default;
+
+public:
+    /**
+     * @brief Lê e interpreta um arquivo de entrada.
+     * @param arquivo O caminho do arquivo.
+     * @return A configuração do caso.
+     */
+    static ConfiguracaoCaso lerArquivo(const std::string& arquivo);
+
+    /**
+     * @brief Interpreta o conteúdo de um arquivo de entrada já em memória.
+     * @param texto O conteúdo do arquivo.
+     * @param arquivo Nome de origem (usado nas mensagens de erro).
+     * @return A configuração do caso.
+     */
+    static ConfiguracaoCaso interpretar(std::string_view texto, const std::string& arquivo);
+
+    /// Arquivo de origem.
+    const std::string& arquivo() const { return _arquivo; }
+
+    /// Viscosidade do óleo (cPoise); -1 se ausente.
+    double mu_o() const { return _mu_o; }
+
+    /// Viscosidade da água (cPoise); -1 se ausente.
+    double mu_w() const { return _mu_w; }
+
+    /// Tipo do modelo de Kr (TABELADO ou COREY).
+    const std::string& tipoModelo() const { return _tipoModelo; }
+
+    /// Saturação inicial; < 0 usa a água conata da curva.
+    double swInicial() const { return _swInicial; }
+
+    /// Passo de saturação das curvas.
+    double passo() const { return _passo; }
+
+    /// Tolerância da curva adaptativa; 0 = malha uniforme.
+    double toleranciaCurva() const { return _toleranciaCurva; }
+
+    /// Número de threads; 0 = todos os núcleos.
+    std::size_t numeroThreads() const { return _numeroThreads; }
+
+    /// Indica se VAZAO_INJECAO foi informada.
+    bool temVazao() const { return _temVazao; }
+
+    /// Parâmetros do deslocamento 1D.
+    const ParametrosDeslocamento1D& deslocamento() const { return _deslocamento; }
+
+    /// Parâmetros de Corey.
+    const ParametrosCorey& corey() const { return _corey; }
+
+    /// Tabela de Kr; sem bloco sem região, é a tabela da primeira região.
+    const TabelaKr& tabela() const { return _tabela; }
+
+    /// Tabelas de Kr por região (vazio se nenhum bloco informou região).
+    const std::vector<TabelaKrRegiao>& tabelasRegioes() const { return _tabelasRegioes; }
+
+    /// Eixos da varredura.
+    const std::vector<EixoVarredura>& eixos() const { return _eixos; }
+
+    /// Dados do modo Monte Carlo.
+    const ParametrosMonteCarlo& monteCarlo() const { return _monteCarlo; }
+
+    /// Pontos iniciais do ajuste de Corey; 0 se o modo não foi pedido.
+    std::size_t ajusteCoreyInicios() const { return _ajusteCoreyInicios; }
+
+    /// Destino dos gráficos.
+    SaidaGrafico saidaGrafico() const { return _saidaGrafico; }
+
+    /// Formato dos arquivos de séries.
+    FormatoSaida formatoSaida() const { return _formatoSaida; }
+};
+
+#endif
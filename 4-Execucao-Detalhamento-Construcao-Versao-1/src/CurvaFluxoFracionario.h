@@ -0,0 +1,104 @@
+#ifndef CURVAFLUXOFRACIONARIO_H
+#define CURVAFLUXOFRACIONARIO_H
+
+#include <vector>
+#include <cmath>     // Para std::ceil
+#include <cstddef>   // Para std::size_t
+#include <stdexcept> // Para std::runtime_error
+#include <utility>   // Para std::move
+
+/**
+ * @class CurvaFluxoFracionario
+ * @brief Curva Fw vs Sw armazenada em vetores paralelos e contíguos.
+ *
+ * Substitui o std::map<double, double>: os pontos ficam em dois blocos de
+ * memória (Sw e Fw), alocados uma única vez no tamanho final, e a curva é
+ * movida (não copiada) ao ser retornada. Os pontos estão em ordem crescente
+ * de Sw e não há chaves em ponto flutuante a comparar. Opcionalmente a
+ * curva guarda também a derivada dfw/dSw em cada ponto.
+ */
+class CurvaFluxoFracionario {
+private:
+    /// Saturações de água dos pontos da curva (crescentes).
+    std::vector<double> _sw;
+
+    /// Fluxo fracionário de água em cada ponto.
+    std::vector<double> _fw;
+
+    /// Derivada dfw/dSw em cada ponto (vazio se não calculada).
+    std::vector<double> _dfw;
+
+public:
+    /**
+     * @brief Cria uma curva vazia.
+     */
+    CurvaFluxoFracionario() = default;
+
+    /**
+     * @brief Cria uma curva com n pontos (valores a preencher).
+     * @param n Número de pontos.
+     * @param comDerivada Se verdadeiro, reserva também a coluna dfw/dSw.
+     */
+    explicit CurvaFluxoFracionario(std::size_t n, bool comDerivada = false)
+    : _sw(n), _fw(n), _dfw(comDerivada ? n : 0) {}
+
+    /**
+     * @brief Cria uma curva sobre saturações já prontas (Fw e dfw a preencher).
+     * @param sw As saturações, em ordem crescente.
+     * @param comDerivada Se verdadeiro, reserva também a coluna dfw/dSw.
+     */
+    CurvaFluxoFracionario(std::vector<double> sw, bool comDerivada)
+    : _sw(std::move(sw)), _fw(_sw.size()), _dfw(comDerivada ? _sw.size() : 0) {}
+
+    /**
+     * @brief Malha uniforme de saturações em [0, 1], a de gerarCurvaCompleta.
+     * Indexada por inteiros (Sw_i = i * passo) e terminando exatamente em 1.0.
+     * @param passo O incremento de Saturação, em (0, 1].
+     * @return As saturações da malha.
+     */
+    static std::vector<double> malhaUniforme(double passo) {
+        if (passo <= 0.0 || passo > 1.0) {
+            throw std::runtime_error("Erro: O passo de saturacao deve estar em (0, 1].");
+        }
+
+        // Índice inteiro evita o acúmulo de erro de sw += passo. A tolerância
+        // evita um intervalo extra quando 1/passo é inteiro a menos de arredondamento.
+        std::size_t nIntervalos = static_cast<std::size_t>(std::ceil(1.0 / passo - 1e-9));
+        std::vector<double> sw(nIntervalos + 1);
+        for (std::size_t i = 0; i < nIntervalos; ++i) {
+            sw[i] = static_cast<double>(i) * passo;
+        }
+        // Garante que o ponto final (1.0) seja sempre calculado
+        sw[nIntervalos] = 1.0;
+        return sw;
+    }
+
+    /// Número de pontos da curva.
+    std::size_t tamanho() const { return _sw.size(); }
+
+    /// Indica se a curva não tem pontos.
+    bool vazia() const { return _sw.empty(); }
+
+    /// Vetor de saturações (Sw).
+    const std::vector<double>& sw() const { return _sw; }
+
+    /// Vetor de fluxos fracionários (Fw).
+    const std::vector<double>& fw() const { return _fw; }
+
+    /// Indica se a curva guarda a derivada dfw/dSw.
+    bool temDerivada() const { return !_dfw.empty(); }
+
+    /// Vetor de derivadas dfw/dSw (vazio se não calculada).
+    const std::vector<double>& dfw() const { return _dfw; }
+
+    /// Vetor de saturações (Sw), para preenchimento.
+    std::vector<double>& sw() { return _sw; }
+
+    /// Vetor de fluxos fracionários (Fw), para preenchimento.
+    std::vector<double>& fw() { return _fw; }
+
+    /// Vetor de derivadas dfw/dSw, para preenchimento.
+    std::vector<double>& dfw() { return _dfw; }
+};
+
+#endif
@@ -1,59 +1,61 @@
 #include "CurvasPermeabilidadeCorey.h"
-#include <iostream>
-#include <fstream>
-#include <sstream>
+#include "ConfiguracaoCaso.h"
 #include <stdexcept>
-#include <cmath>     // Para std::pow
-#include <algorithm> // Para std::max e std::min
 
 /**
- * @brief Carrega os parâmetros do modelo de Corey do arquivo de entrada.
- * @param arquivo O caminho para o arquivo de configuração .txt.
+ * @brief Constrói o modelo a partir dos parâmetros.
+ * @param p Os 6 parâmetros do modelo.
  */
-void CurvasPermeabilidadeCorey::carregarDados(const std::string& arquivo) {
-    // Seta valores padrão inválidos para checagem
-    _swir = _sorw = _krw_max = _kro_max = _nw = _no = -1.0;
-
-    std::ifstream arq(arquivo);
-    if (!arq.is_open()) {
-        throw std::runtime_error("Erro (Corey): Nao foi possivel abrir o arquivo: " + arquivo);
-    }
-
-    std::string linha;
-    std::string palavraChave;
+CurvasPermeabilidadeCorey::CurvasPermeabilidadeCorey(const ParametrosCorey& p)
+: _swir(p.swir), _sorw(p.sorw), _krw_max(p.krw_max), _kro_max(p.kro_max), _nw(p.nw), _no(p.no),
+  _kernel() {
+    validarParametros();
 
-    while (std::getline(arq, linha)) {
-        if (linha.empty() || linha[0] == '#') continue;
-
-        std::stringstream ss(linha);
-        ss >> palavraChave;
+    // Parâmetros do kernel, compartilhados pelo cálculo de um ponto e pelo lote
+    _kernel.swir = _swir;
+    _kernel.inversoDenominador = 1.0 / (1.0 - _swir - _sorw);
+    _kernel.krw_max = _krw_max;
+    _kernel.kro_max = _kro_max;
+    _kernel.nw = _nw;
+    _kernel.no = _no;
+    _kernel.formaNw = ExpoenteCorey::classificar(_nw);
+    _kernel.formaNo = ExpoenteCorey::classificar(_no);
+}
 
-        // Lê e armazena cada parâmetro
-        if (palavraChave == "COREY_SWIR")     ss >> _swir;
-        else if (palavraChave == "COREY_SORW")    ss >> _sorw;
-        else if (palavraChave == "COREY_KRW_MAX") ss >> _krw_max;
-        else if (palavraChave == "COREY_KRO_MAX") ss >> _kro_max;
-        else if (palavraChave == "COREY_NW")      ss >> _nw;
-        else if (palavraChave == "COREY_NO")      ss >> _no;
-    }
+/**
+ * @brief Retorna os parâmetros atuais do modelo.
+ */
+ParametrosCorey CurvasPermeabilidadeCorey::getParametros() const {
+    return ParametrosCorey{_swir, _sorw, _krw_max, _kro_max, _nw, _no};
+}
 
-    // Validação simples
+/**
+ * @brief Verifica se os parâmetros são válidos.
+ */
+void CurvasPermeabilidadeCorey::validarParametros() const {
     if (_swir < 0 || _sorw < 0 || _krw_max < 0 || _kro_max < 0 || _nw < 0 || _no < 0) {
         throw std::runtime_error("Erro: Um ou mais parametros do modelo Corey nao foram carregados corretamente.");
     }
-    std::cout << "DEBUG: Parametros de Corey carregados com sucesso.\n";
+    if (_swir + _sorw >= 1.0) {
+        throw std::runtime_error("Erro: COREY_SWIR + COREY_SORW deve ser menor que 1.");
+    }
 }
 
 /**
- * @brief Calcula a Saturação Normalizada (Sw_norm).
- * Privado, apenas para uso interno desta classe.
+ * @brief Carrega os parâmetros do modelo de Corey do arquivo de entrada.
+ * A leitura é feita por ConfiguracaoCaso (uma passada, sem stringstream).
+ * @param arquivo O caminho para o arquivo de configuração .txt.
  */
-double calcularSwNorm(double sw, double swir, double sorw) {
-    // Fórmula: Sw_norm = (Sw - Swir) / (1 - Swir - Sorw)
-    double sw_norm = (sw - swir) / (1.0 - swir - sorw);
+void CurvasPermeabilidadeCorey::carregarDados(const std::string& arquivo) {
+    // Parâmetros ausentes chegam como -1 e são rejeitados na validação
+    *this = CurvasPermeabilidadeCorey(ConfiguracaoCaso::lerArquivo(arquivo).corey());
+}
 
-    // Limita o resultado entre 0 e 1 (clamp)
-    return std::max(0.0, std::min(1.0, sw_norm));
+/**
+ * @brief Retorna os limites da faixa móvel, onde Krw e Kro deixam de ser constantes.
+ */
+std::vector<double> CurvasPermeabilidadeCorey::pontosDeQuebra() const {
+    return {_swir, 1.0 - _sorw};
 }
 
 /**
@@ -62,11 +64,10 @@ double calcularSwNorm(double sw, double swir, double sorw) {
  * @return Valor de Krw.
  */
 double CurvasPermeabilidadeCorey::getKrw(double sw) const {
-    // 1. Calcular Sw_norm
-    double sw_norm = calcularSwNorm(sw, _swir, _sorw);
-
-    // 2. Fórmula de Corey para Krw: krw = krw_max * (Sw_norm ^ nw)
-    return _krw_max * std::pow(sw_norm, _nw);
+    // krw = krw_max * (Sw_norm ^ nw), pelo mesmo kernel do lote
+    double krw, kro;
+    calcularKrPonto(sw, krw, kro);
+    return krw;
 }
 
 /**
@@ -75,9 +76,50 @@ double CurvasPermeabilidadeCorey::getKrw(double sw) const {
  * @return Valor de Kro.
  */
 double CurvasPermeabilidadeCorey::getKro(double sw) const {
-    // 1. Calcular Sw_norm
-    double sw_norm = calcularSwNorm(sw, _swir, _sorw);
+    // kro = kro_max * ((1 - Sw_norm) ^ no), pelo mesmo kernel do lote
+    double krw, kro;
+    calcularKrPonto(sw, krw, kro);
+    return kro;
+}
 
-    // 2. Fórmula de Corey para Kro: kro = kro_max * ((1 - Sw_norm) ^ no)
-    return _kro_max * std::pow(1.0 - sw_norm, _no);
+/**
+ * @brief Calcula Krw e Kro de Corey para um lote de saturações.
+ * Delega ao KernelCoreySimd (AVX2/SSE2, escolhido em tempo de execução).
+ * @param sw Vetor de saturações de água.
+ * @param krw Vetor de saída para Krw.
+ * @param kro Vetor de saída para Kro.
+ * @param n Número de pontos.
+ */
+void CurvasPermeabilidadeCorey::calcularKrLote(const double* sw, double* krw, double* kro, std::size_t n) const {
+    KernelCoreySimd::calcularKr(_kernel, sw, krw, kro, n);
+}
+
+/**
+ * @brief Calcula Krw, Kro e suas derivadas analíticas para um lote.
+ * @param sw Vetor de saturações de água.
+ * @param krw Vetor de saída para Krw.
+ * @param kro Vetor de saída para Kro.
+ * @param dkrw Vetor de saída para dKrw/dSw.
+ * @param dkro Vetor de saída para dKro/dSw.
+ * @param n Número de pontos.
+ */
+void CurvasPermeabilidadeCorey::calcularKrDerivadaLote(const double* sw, double* krw, double* kro,
+                                                       double* dkrw, double* dkro, std::size_t n) const {
+    // 1. Valores pelo kernel vetorizado
+    calcularKrLote(sw, krw, kro, n);
+
+    // 2. Derivadas reaproveitando as potências já calculadas:
+    //    d(s^nw)/dSw = nw * s^nw / s * dS/dSw, com dS/dSw = 1 / (1 - Swir - Sorw)
+    const double inv = 1.0 / (1.0 - _swir - _sorw);
+    for (std::size_t i = 0; i < n; ++i) {
+        double s = (sw[i] - _swir) * inv;
+        if (s > 0.0 && s < 1.0) {
+            dkrw[i] = _nw * krw[i] / s * inv;
+            dkro[i] = -_no * kro[i] / (1.0 - s) * inv;
+        } else {
+            // Fora da faixa móvel a saturação normalizada está travada (clamp)
+            dkrw[i] = 0.0;
+            dkro[i] = 0.0;
+        }
+    }
 }
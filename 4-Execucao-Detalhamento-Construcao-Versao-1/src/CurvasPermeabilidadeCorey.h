@@ -2,16 +2,44 @@
 #define CURVASPERMEABILIDADECOREY_H
 
 #include "ICurvasPermeabilidade.h"
+#include "KernelCoreySimd.h"
 #include <string> // Incluído para std::string
 
+/**
+ * @struct ParametrosCorey
+ * @brief Os 6 parâmetros do modelo de Corey.
+ */
+struct ParametrosCorey {
+    /// Saturação de água irreduzível (Swir)
+    double swir;
+
+    /// Saturação de óleo residual (Sorw)
+    double sorw;
+
+    /// Permeabilidade relativa máxima da água (no Sorw)
+    double krw_max;
+
+    /// Permeabilidade relativa máxima do óleo (no Swir)
+    double kro_max;
+
+    /// Expoente de Corey para a água (nw)
+    double nw;
+
+    /// Expoente de Corey para o óleo (no)
+    double no;
+};
+
 /**
  * @class CurvasPermeabilidadeCorey
  * @brief Implementação concreta da interface ICurvasPermeabilidade para o modelo de Corey.
  *
  * Esta classe lê os 6 parâmetros do modelo de Corey do arquivo de entrada
  * e calcula Krw/Kro analiticamente usando as fórmulas de Corey.
+ *
+ * A classe é final: chamadas por uma referência do tipo concreto são
+ * resolvidas em tempo de compilação (ver CalculadoraFluxoFracionarioEspecializada).
  */
-class CurvasPermeabilidadeCorey : public ICurvasPermeabilidade {
+class CurvasPermeabilidadeCorey final : public ICurvasPermeabilidade {
 private:
     /// Saturação de água irreduzível (Swir)
     double _swir;
@@ -31,7 +59,34 @@ private:
     /// Expoente de Corey para o óleo (no)
     double _no;
 
+    /// Parâmetros preparados para o KernelCoreySimd (inverso do denominador e
+    /// formas de nw e no), montados uma única vez, com os parâmetros
+    ParametrosKernelCorey _kernel;
+
+    /**
+     * @brief Verifica se os parâmetros carregados são válidos.
+     */
+    void validarParametros() const;
+
 public:
+    /**
+     * @brief Construtor padrão; os parâmetros vêm depois, por carregarDados.
+     */
+    CurvasPermeabilidadeCorey() = default;
+
+    /**
+     * @brief Constrói o modelo diretamente a partir dos parâmetros (sem arquivo).
+     * Usado, por exemplo, na varredura de parâmetros. Os expoentes inteiros
+     * e semi-inteiros são detectados aqui e usam potências especializadas.
+     * @param p Os 6 parâmetros do modelo.
+     */
+    explicit CurvasPermeabilidadeCorey(const ParametrosCorey& p);
+
+    /**
+     * @brief Retorna os parâmetros atuais do modelo.
+     */
+    ParametrosCorey getParametros() const;
+
     /**
      * @brief Carrega os 6 parâmetros do modelo Corey do arquivo.
      * @param arquivo O caminho para o arquivo de configuração .txt.
@@ -51,6 +106,50 @@ public:
      * @return O valor de Kro analítico.
      */
     double getKro(double sw) const override;
+
+    /**
+     * @brief Pontos de quebra: Swir e 1 - Sorw (limites da faixa móvel).
+     */
+    std::vector<double> pontosDeQuebra() const override;
+
+    /**
+     * @brief Calcula Krw e Kro de um ponto, normalizando Sw uma única vez.
+     * Passa pelo mesmo KernelCoreySimd do lote, de modo que
+     * calcularFw(sw) e calcularFwLote dão exatamente os mesmos bits; o
+     * refinamento de Welge, feito ponto a ponto, fica coerente com a
+     * envoltória montada em lote.
+     * @param sw A saturação de água.
+     * @param krw Saída: o valor de Krw.
+     * @param kro Saída: o valor de Kro.
+     */
+    void calcularKrPonto(double sw, double& krw, double& kro) const override {
+        KernelCoreySimd::calcularKrPonto(_kernel, sw, krw, kro);
+    }
+
+    /**
+     * @brief Calcula Krw e Kro para um lote de saturações.
+     * A saturação normalizada é calculada uma única vez por ponto.
+     * @param sw Vetor de entrada com as saturações de água.
+     * @param krw Vetor de saída para Krw.
+     * @param kro Vetor de saída para Kro.
+     * @param n Número de saturações do lote.
+     */
+    void calcularKrLote(const double* sw, double* krw, double* kro, std::size_t n) const override;
+
+    /**
+     * @brief Calcula Krw, Kro e as derivadas analíticas de Corey para um lote.
+     * dKrw/dSw = nw * Krw / Sw_norm / (1 - Swir - Sorw) e
+     * dKro/dSw = -no * Kro / (1 - Sw_norm) / (1 - Swir - Sorw) dentro de
+     * (Swir, 1 - Sorw); zero fora da faixa móvel.
+     * @param sw Vetor de entrada com as saturações de água.
+     * @param krw Vetor de saída para Krw.
+     * @param kro Vetor de saída para Kro.
+     * @param dkrw Vetor de saída para dKrw/dSw.
+     * @param dkro Vetor de saída para dKro/dSw.
+     * @param n Número de saturações do lote.
+     */
+    void calcularKrDerivadaLote(const double* sw, double* krw, double* kro,
+                                double* dkrw, double* dkro, std::size_t n) const override;
 };
 
 #endif
@@ -1,56 +1,163 @@
 #include "CurvasPermeabilidadeTabelada.h"
-#include <iostream>
-#include <fstream>
-#include <sstream>
+#include "ConfiguracaoCaso.h"
 #include <stdexcept>
+#include <algorithm> // Para std::stable_sort
+#include <cmath>     // Para std::fabs
+#include <numeric>   // Para std::iota
 
 /**
- * @brief Carrega os dados tabelados (Sw, Krw, Kro) do arquivo de entrada.
- * @param arquivo O caminho para o arquivo de configuração .txt.
+ * @brief Constrói o modelo a partir de uma tabela já lida.
+ * @param tabela As linhas da tabela e o número de baldes do índice uniforme.
  */
-void CurvasPermeabilidadeTabelada::carregarDados(const std::string& arquivo) {
-    std::ifstream arq(arquivo);
-    if (!arq.is_open()) {
-        throw std::runtime_error("Erro (Tabelado): Nao foi possivel abrir o arquivo: " + arquivo);
+CurvasPermeabilidadeTabelada::CurvasPermeabilidadeTabelada(const TabelaKr& tabela)
+: _sw(tabela.sw), _krw(tabela.krw), _kro(tabela.kro) {
+    if (_sw.empty()) {
+        throw std::runtime_error("Erro: Nenhum dado de permeabilidade encontrado (bloco DADOS_KR_INICIO...FIM_DADOS) no arquivo.");
     }
 
-    std::string linha;
-    bool lendoDados = false;
+    preprocessarTabela();
+    if (tabela.interpolacao == InterpolacaoKr::Pchip) {
+        construirCubicaPchip();
+    }
+    construirIndiceUniforme(tabela.indiceUniforme);
+}
 
-    while (std::getline(arq, linha)) {
-        if (linha.empty() || linha[0] == '#') continue;
+/**
+ * @brief Carrega os dados tabelados (Sw, Krw, Kro) do arquivo de entrada.
+ * A leitura é feita por ConfiguracaoCaso (uma passada, sem stringstream).
+ * @param arquivo O caminho para o arquivo de configuração .txt.
+ */
+void CurvasPermeabilidadeTabelada::carregarDados(const std::string& arquivo) {
+    // Uma nova carga substitui a tabela anterior
+    *this = CurvasPermeabilidadeTabelada(ConfiguracaoCaso::lerArquivo(arquivo).tabela());
+}
 
-        std::stringstream ss(linha);
-        std::string palavraChave;
-        ss >> palavraChave; // Lê a primeira "palavra"
+/**
+ * @brief Ordena a tabela por Sw, remove Sw repetidos e pré-calcula as inclinações.
+ */
+void CurvasPermeabilidadeTabelada::preprocessarTabela() {
+    // 1. Ordenar por Sw (ordenação estável: entre Sw iguais vale a ordem do arquivo)
+    std::vector<std::size_t> ordem(_sw.size());
+    std::iota(ordem.begin(), ordem.end(), 0);
+    std::stable_sort(ordem.begin(), ordem.end(),
+                     [this](std::size_t a, std::size_t b) { return _sw[a] < _sw[b]; });
 
-        if (palavraChave == "DADOS_KR_INICIO") {
-            lendoDados = true;
+    // 2. Remover Sw repetidos, mantendo a primeira linha de cada valor
+    std::vector<double> sw, krw, kro;
+    sw.reserve(ordem.size());
+    krw.reserve(ordem.size());
+    kro.reserve(ordem.size());
+    for (std::size_t i : ordem) {
+        if (!sw.empty() && _sw[i] == sw.back()) {
             continue;
         }
+        sw.push_back(_sw[i]);
+        krw.push_back(_krw[i]);
+        kro.push_back(_kro[i]);
+    }
+    _sw.swap(sw);
+    _krw.swap(krw);
+    _kro.swap(kro);
 
-        if (palavraChave == "FIM_DADOS") {
-            lendoDados = false;
-            break;
-        }
+    // 3. Inclinações de cada segmento (sem segmentos de largura zero após a limpeza)
+    std::size_t nSeg = _sw.size() - 1;
+    _dKrw.assign(nSeg, 0.0);
+    _dKro.assign(nSeg, 0.0);
+    for (std::size_t i = 0; i < nSeg; ++i) {
+        double dx = _sw[i + 1] - _sw[i];
+        _dKrw[i] = (_krw[i + 1] - _krw[i]) / dx;
+        _dKro[i] = (_kro[i + 1] - _kro[i]) / dx;
+    }
+}
 
-        if (lendoDados) {
-            // Se estamos lendo, a "palavraChave" é na verdade o valor do Sw
-            std::stringstream ss_linha(linha);
-            double sw, krw, kro;
-            ss_linha >> sw >> krw >> kro;
+/**
+ * @brief Calcula os coeficientes PCHIP (Fritsch-Carlson) de cada segmento.
+ */
+void CurvasPermeabilidadeTabelada::construirCubicaPchip() {
+    const std::size_t n = _sw.size();
+    _cubica.clear();
+    if (n < 2) {
+        return;
+    }
 
-            // Adiciona os valores aos vetores da classe
-            _sw.push_back(sw);
-            _krw.push_back(krw);
-            _kro.push_back(kro);
+    // Derivadas nos pontos da tabela para uma coluna (Krw ou Kro), a partir
+    // das inclinações dos segmentos já calculadas em preprocessarTabela
+    auto derivadas = [&](const std::vector<double>& delta) {
+        std::vector<double> d(n, 0.0);
+        if (n == 2) {
+            d[0] = d[1] = delta[0]; // um único segmento: reta
+            return d;
+        }
+        // Pontos internos: média harmônica ponderada; zero em extremos locais
+        for (std::size_t k = 1; k + 1 < n; ++k) {
+            if (delta[k - 1] * delta[k] <= 0.0) {
+                continue;
+            }
+            double h0 = _sw[k] - _sw[k - 1];
+            double h1 = _sw[k + 1] - _sw[k];
+            double w1 = 2.0 * h1 + h0;
+            double w2 = h1 + 2.0 * h0;
+            d[k] = (w1 + w2) / (w1 / delta[k - 1] + w2 / delta[k]);
         }
+        // Pontas: fórmula de três pontos, limitada para preservar a forma
+        auto ponta = [](double h0, double h1, double delta0, double delta1) {
+            double dp = ((2.0 * h0 + h1) * delta0 - h0 * delta1) / (h0 + h1);
+            if (dp * delta0 <= 0.0) {
+                return 0.0;
+            }
+            if (delta0 * delta1 <= 0.0 && std::fabs(dp) > 3.0 * std::fabs(delta0)) {
+                return 3.0 * delta0;
+            }
+            return dp;
+        };
+        d[0] = ponta(_sw[1] - _sw[0], _sw[2] - _sw[1], delta[0], delta[1]);
+        d[n - 1] = ponta(_sw[n - 1] - _sw[n - 2], _sw[n - 2] - _sw[n - 3], delta[n - 2], delta[n - 3]);
+        return d;
+    };
+    const std::vector<double> dw = derivadas(_dKrw);
+    const std::vector<double> dOleo = derivadas(_dKro);
+
+    // Coeficientes de Hermite de cada segmento, em sequência na memória
+    auto coeficientes = [](double y, double d0, double d1, double delta, double h, double* c) {
+        c[0] = y;
+        c[1] = d0;
+        c[2] = (3.0 * delta - 2.0 * d0 - d1) / h;
+        c[3] = (d0 + d1 - 2.0 * delta) / (h * h);
+    };
+    _cubica.resize(n - 1);
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        double h = _sw[i + 1] - _sw[i];
+        coeficientes(_krw[i], dw[i], dw[i + 1], _dKrw[i], h, _cubica[i].krw);
+        coeficientes(_kro[i], dOleo[i], dOleo[i + 1], _dKro[i], h, _cubica[i].kro);
     }
+}
 
-    if (_sw.empty()) {
-        throw std::runtime_error("Erro: Nenhum dado de permeabilidade encontrado (bloco DADOS_KR_INICIO...FIM_DADOS) no arquivo.");
+/**
+ * @brief Constrói o índice uniforme de baldes sobre a faixa de Sw da tabela.
+ * @param nBaldes Número de baldes (0 desativa o índice).
+ */
+void CurvasPermeabilidadeTabelada::construirIndiceUniforme(std::size_t nBaldes) {
+    _indiceUniforme.clear();
+    _inversoLarguraBalde = 0.0;
+
+    // Tabela com um único ponto não tem segmentos para indexar
+    if (nBaldes == 0 || _sw.size() < 2) {
+        return;
+    }
+
+    double largura = (_sw.back() - _sw.front()) / static_cast<double>(nBaldes);
+    _inversoLarguraBalde = 1.0 / largura;
+    _indiceUniforme.resize(nBaldes);
+
+    // Cada balde aponta para o segmento que contém seu início
+    std::size_t i = 0;
+    for (std::size_t b = 0; b < nBaldes; ++b) {
+        double inicio = _sw.front() + static_cast<double>(b) * largura;
+        while (i < _sw.size() - 2 && _sw[i + 1] <= inicio) {
+            ++i;
+        }
+        _indiceUniforme[b] = i;
     }
-    std::cout << "DEBUG: " << _sw.size() << " pontos de Kr tabelados foram carregados.\n";
 }
 
 /**
@@ -59,7 +166,12 @@ void CurvasPermeabilidadeTabelada::carregarDados(const std::string& arquivo) {
  * @return Valor de Krw interpolado.
  */
 double CurvasPermeabilidadeTabelada::getKrw(double sw) const {
-    return interpolar(sw, _sw, _krw); // Chama a função de interpolação
+    if (!_cubica.empty()) {
+        double krw, kro;
+        calcularKrPonto(sw, krw, kro);
+        return krw;
+    }
+    return interpolar(sw, _krw, _dKrw); // Chama a função de interpolação
 }
 
 /**
@@ -68,52 +180,118 @@ double CurvasPermeabilidadeTabelada::getKrw(double sw) const {
  * @return Valor de Kro interpolado.
  */
 double CurvasPermeabilidadeTabelada::getKro(double sw) const {
-    return interpolar(sw, _sw, _kro); // Chama a função de interpolação
+    if (!_cubica.empty()) {
+        double krw, kro;
+        calcularKrPonto(sw, krw, kro);
+        return kro;
+    }
+    return interpolar(sw, _kro, _dKro); // Chama a função de interpolação
 }
 
 /**
  * @brief Algoritmo de Interpolação Linear (e extrapolação de ponta).
  * Este é o algoritmo detalhado no Diagrama de Atividades.
  * @param x_desejado A saturação (Sw) que queremos.
- * @param vec_x O vetor de Saturações da tabela.
  * @param vec_y O vetor de Krw ou Kro correspondente.
+ * @param inclinacao O vetor de inclinações por segmento de vec_y.
  * @return O valor de y (Kr) interpolado.
  */
-double CurvasPermeabilidadeTabelada::interpolar(double x_desejado, const std::vector<double>& vec_x, const std::vector<double>& vec_y) const {
+double CurvasPermeabilidadeTabelada::interpolar(double x_desejado, const std::vector<double>& vec_y, const std::vector<double>& inclinacao) const {
 
     // Caso 1: Extrapolação (abaixo do limite inferior)
-    if (x_desejado <= vec_x.front()) {
+    if (x_desejado <= _sw.front()) {
         return vec_y.front();
     }
 
     // Caso 2: Extrapolação (acima do limite superior)
-    if (x_desejado >= vec_x.back()) {
+    if (x_desejado >= _sw.back()) {
         return vec_y.back();
     }
 
-    // Caso 3: Interpolação (procurar o intervalo)
-    for (size_t i = 0; i < vec_x.size() - 1; ++i) {
-
-        // Achamos o intervalo: vec_x[i] <= x_desejado <= vec_x[i+1]
-        if (x_desejado >= vec_x[i] && x_desejado <= vec_x[i+1]) {
+    // Caso 3: Interpolação no segmento localizado
+    // y = y0 + (x - x0) * inclinacao
+    std::size_t i = localizarSegmento(x_desejado);
+    return vec_y[i] + (x_desejado - _sw[i]) * inclinacao[i];
+}
 
-            // Pontos do intervalo
-            double x0 = vec_x[i];
-            double y0 = vec_y[i];
-            double x1 = vec_x[i+1];
-            double y1 = vec_y[i+1];
+/**
+ * @brief Calcula Krw e Kro para um lote de saturações.
+ * Para cada ponto, o segmento da tabela é procurado uma única vez e
+ * reaproveitado pelas duas interpolações.
+ * @param sw Vetor de saturações de água.
+ * @param krw Vetor de saída para Krw.
+ * @param kro Vetor de saída para Kro.
+ * @param n Número de pontos.
+ */
+void CurvasPermeabilidadeTabelada::calcularKrLote(const double* sw, double* krw, double* kro, std::size_t n) const {
+    for (std::size_t k = 0; k < n; ++k) {
+        double x = sw[k];
 
-            // Evita divisão por zero se os pontos Sw forem idênticos
-            if (x1 == x0) {
-                return y0;
-            }
+        // Extrapolação de ponta (mesma regra de interpolar)
+        if (x <= _sw.front()) {
+            krw[k] = _krw.front();
+            kro[k] = _kro.front();
+            continue;
+        }
+        if (x >= _sw.back()) {
+            krw[k] = _krw.back();
+            kro[k] = _kro.back();
+            continue;
+        }
 
-            // Fórmula da Interpolação Linear:
-            // y = y0 + (x - x0) * (y1 - y0) / (x1 - x0)
-            return y0 + (x_desejado - x0) * (y1 - y0) / (x1 - x0);
+        // Um único segmento para Krw e Kro
+        std::size_t i = localizarSegmento(x);
+        double dx = x - _sw[i];
+        if (!_cubica.empty()) {
+            avaliarCubica(_cubica[i], dx, krw[k], kro[k]);
+            continue;
         }
+        krw[k] = _krw[i] + dx * _dKrw[i];
+        kro[k] = _kro[i] + dx * _dKro[i];
     }
+}
 
-    // Se algo der muito errado (não deveria acontecer)
-    return vec_y.back();
+/**
+ * @brief Calcula Krw, Kro e as derivadas (inclinação do segmento) para um lote.
+ * @param sw Vetor de saturações de água.
+ * @param krw Vetor de saída para Krw.
+ * @param kro Vetor de saída para Kro.
+ * @param dkrw Vetor de saída para dKrw/dSw.
+ * @param dkro Vetor de saída para dKro/dSw.
+ * @param n Número de pontos.
+ */
+void CurvasPermeabilidadeTabelada::calcularKrDerivadaLote(const double* sw, double* krw, double* kro,
+                                                          double* dkrw, double* dkro, std::size_t n) const {
+    for (std::size_t k = 0; k < n; ++k) {
+        double x = sw[k];
+
+        // Fora da tabela o valor é constante (extrapolação de ponta)
+        if (x < _sw.front() || _sw.size() < 2) {
+            krw[k] = _krw.front();
+            kro[k] = _kro.front();
+            dkrw[k] = dkro[k] = 0.0;
+            continue;
+        }
+        if (x >= _sw.back()) {
+            krw[k] = _krw.back();
+            kro[k] = _kro.back();
+            dkrw[k] = dkro[k] = 0.0;
+            continue;
+        }
+
+        std::size_t i = localizarSegmento(x);
+        double dx = x - _sw[i];
+        if (!_cubica.empty()) {
+            // Derivada da cúbica: c1 + 2*c2*dx + 3*c3*dx^2
+            const SegmentoCubicoKr& seg = _cubica[i];
+            avaliarCubica(seg, dx, krw[k], kro[k]);
+            dkrw[k] = (3.0 * seg.krw[3] * dx + 2.0 * seg.krw[2]) * dx + seg.krw[1];
+            dkro[k] = (3.0 * seg.kro[3] * dx + 2.0 * seg.kro[2]) * dx + seg.kro[1];
+            continue;
+        }
+        krw[k] = _krw[i] + dx * _dKrw[i];
+        kro[k] = _kro[i] + dx * _dKro[i];
+        dkrw[k] = _dKrw[i];
+        dkro[k] = _dKro[i];
+    }
 }
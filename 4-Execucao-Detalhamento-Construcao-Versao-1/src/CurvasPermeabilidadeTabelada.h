@@ -2,17 +2,74 @@
 #define CURVASPERMEABILIDADETABELADA_H
 
 #include "ICurvasPermeabilidade.h"
+#include <algorithm> // Para std::upper_bound
 #include <vector>
 #include <string> // Incluído para std::string
 
+/**
+ * @brief Interpolação da tabela de Kr (palavra-chave INTERPOLACAO_KR).
+ */
+enum class InterpolacaoKr {
+    Linear, ///< LINEAR: por segmentos de reta (padrão)
+    Pchip   ///< PCHIP: cúbica monótona de Hermite (Fritsch-Carlson)
+};
+
+/**
+ * @struct SegmentoCubicoKr
+ * @brief Coeficientes da cúbica de Krw e Kro num segmento da tabela.
+ *
+ * Kr(Sw) = c0 + c1*dx + c2*dx^2 + c3*dx^3, com dx = Sw - Sw_i. Os 8
+ * coeficientes de um segmento ocupam exatamente uma linha de cache.
+ */
+struct alignas(64) SegmentoCubicoKr {
+    /// Coeficientes c0..c3 de Krw.
+    double krw[4];
+
+    /// Coeficientes c0..c3 de Kro.
+    double kro[4];
+};
+
+/**
+ * @struct TabelaKr
+ * @brief Tabela de Kr como lida do arquivo (bloco DADOS_KR_INICIO ... FIM_DADOS).
+ */
+struct TabelaKr {
+    /// Saturações de água, na ordem do arquivo.
+    std::vector<double> sw;
+
+    /// Krw de cada linha.
+    std::vector<double> krw;
+
+    /// Kro de cada linha.
+    std::vector<double> kro;
+
+    /// Número de baldes do índice uniforme (INDICE_UNIFORME_KR); 0 = busca binária.
+    std::size_t indiceUniforme = 0;
+
+    /// Interpolação entre as linhas (INTERPOLACAO_KR).
+    InterpolacaoKr interpolacao = InterpolacaoKr::Linear;
+};
+
 /**
  * @class CurvasPermeabilidadeTabelada
  * @brief Implementação concreta da interface ICurvasPermeabilidade para dados tabulados.
  *
  * Esta classe lê uma tabela de Sw, Krw e Kro de um arquivo de entrada e usa
- * interpolação linear para calcular valores intermediários.
+ * interpolação linear para calcular valores intermediários ou, com
+ * INTERPOLACAO_KR PCHIP, uma cúbica monótona por segmentos (PCHIP), que dá
+ * curvas e derivadas suaves sem criar oscilações, com tabelas menores.
+ *
+ * Na carga a tabela é ordenada por Sw, linhas com Sw repetido são descartadas
+ * (vale a primeira) e as inclinações de cada segmento são pré-calculadas. A
+ * busca do segmento é binária (O(log n)) ou, se o índice uniforme estiver
+ * ativo (palavra-chave INDICE_UNIFORME_KR), O(1) em média. No modo PCHIP os
+ * coeficientes de cada segmento são calculados uma vez na carga e guardados
+ * em sequência; avaliar um ponto é buscar o segmento e aplicar Horner.
+ *
+ * A classe é final e a busca do segmento é definida em linha, para que a
+ * CalculadoraFluxoFracionarioEspecializada expanda o cálculo de um ponto.
  */
-class CurvasPermeabilidadeTabelada : public ICurvasPermeabilidade {
+class CurvasPermeabilidadeTabelada final : public ICurvasPermeabilidade {
 private:
     /// Vetor com os valores de Saturação de Água da tabela.
     std::vector<double> _sw;
@@ -23,23 +80,92 @@ private:
     /// Vetor com os valores de Kro da tabela.
     std::vector<double> _kro;
 
+    /// Inclinação de Krw em cada segmento [i, i+1] da tabela.
+    std::vector<double> _dKrw;
+
+    /// Inclinação de Kro em cada segmento [i, i+1] da tabela.
+    std::vector<double> _dKro;
+
+    /// Coeficientes da cúbica PCHIP de cada segmento (vazio = interpolação linear).
+    std::vector<SegmentoCubicoKr> _cubica;
+
+    /// Índice uniforme: para cada balde da malha, o segmento que contém seu início (vazio = busca binária).
+    std::vector<std::size_t> _indiceUniforme;
+
+    /// Inverso da largura de um balde do índice uniforme.
+    double _inversoLarguraBalde = 0.0;
+
+    /**
+     * @brief Ordena a tabela por Sw, remove Sw repetidos e pré-calcula as inclinações.
+     */
+    void preprocessarTabela();
+
+    /**
+     * @brief Calcula os coeficientes PCHIP de todos os segmentos.
+     * Derivadas nos pontos pela média harmônica ponderada das inclinações
+     * vizinhas (zero em extremos locais), com a fórmula de três pontos nas
+     * pontas; assim a cúbica preserva a monotonicidade dos dados.
+     */
+    void construirCubicaPchip();
+
+    /**
+     * @brief Avalia Krw e Kro na cúbica de um segmento (Horner).
+     * @param seg Coeficientes do segmento.
+     * @param dx Distância ao início do segmento.
+     * @param krw Saída: Krw.
+     * @param kro Saída: Kro.
+     */
+    static void avaliarCubica(const SegmentoCubicoKr& seg, double dx, double& krw, double& kro) {
+        krw = ((seg.krw[3] * dx + seg.krw[2]) * dx + seg.krw[1]) * dx + seg.krw[0];
+        kro = ((seg.kro[3] * dx + seg.kro[2]) * dx + seg.kro[1]) * dx + seg.kro[0];
+    }
+
+    /**
+     * @brief Localiza o segmento i tal que _sw[i] <= x < _sw[i+1].
+     * Só deve ser chamado para x estritamente dentro da tabela.
+     * @param x A saturação procurada.
+     * @return O índice do início do segmento.
+     */
+    std::size_t localizarSegmento(double x) const;
+
     /**
      * @brief Algoritmo de Interpolação Linear (e extrapolação de ponta).
-     * Este é o algoritmo detalhado no Diagrama de Atividades.
+     * Este é o algoritmo detalhado no Diagrama de Atividades, agora com a
+     * busca do segmento feita por localizarSegmento.
      * @param x_desejado A saturação (Sw) que queremos.
-     * @param vec_x O vetor de Saturações da tabela (_sw).
      * @param vec_y O vetor de Krw ou Kro correspondente.
+     * @param inclinacao O vetor de inclinações por segmento de vec_y.
      * @return O valor de y (Kr) interpolado.
      */
-    double interpolar(double x_desejado, const std::vector<double>& vec_x, const std::vector<double>& vec_y) const;
+    double interpolar(double x_desejado, const std::vector<double>& vec_y, const std::vector<double>& inclinacao) const;
 
 public:
+    /**
+     * @brief Construtor padrão; a tabela vem depois, por carregarDados.
+     */
+    CurvasPermeabilidadeTabelada() = default;
+
+    /**
+     * @brief Constrói o modelo a partir de uma tabela já lida (ver ConfiguracaoCaso).
+     * @param tabela As linhas (Sw, Krw, Kro) e o número de baldes do índice uniforme.
+     */
+    explicit CurvasPermeabilidadeTabelada(const TabelaKr& tabela);
+
     /**
      * @brief Carrega os dados da tabela (bloco DADOS_KR_INICIO) do arquivo.
      * @param arquivo O caminho para o arquivo de configuração .txt.
      */
     void carregarDados(const std::string& arquivo) override;
 
+    /**
+     * @brief Constrói o índice uniforme para busca do segmento em O(1).
+     * A faixa [Sw mínimo, Sw máximo] é dividida em baldes de mesma largura;
+     * cada balde guarda o segmento onde começa. Com nBaldes da ordem do número
+     * de linhas, cada consulta percorre em média no máximo um segmento.
+     * @param nBaldes Número de baldes (0 desativa o índice e volta à busca binária).
+     */
+    void construirIndiceUniforme(std::size_t nBaldes);
+
     /**
      * @brief Obtém o Krw, usando interpolação se necessário.
      * @param sw A saturação de água.
@@ -53,6 +179,113 @@ public:
      * @return O valor de Kro interpolado.
      */
     double getKro(double sw) const override;
+
+    /**
+     * @brief Saturações da tabela, já ordenadas e sem repetição.
+     */
+    const std::vector<double>& saturacoes() const { return _sw; }
+
+    /**
+     * @brief Coeficientes do segmento [i, i+1] na forma cúbica.
+     * No modo linear, c0 é o valor no início do segmento, c1 a inclinação e
+     * c2 = c3 = 0. Usado por TabelasKrRegioes para empacotar a tabela.
+     * @param i Índice do segmento (menor que saturacoes().size() - 1).
+     * @return Os coeficientes de Krw e Kro.
+     */
+    SegmentoCubicoKr segmento(std::size_t i) const {
+        if (!_cubica.empty()) {
+            return _cubica[i];
+        }
+        return SegmentoCubicoKr{{_krw[i], _dKrw[i], 0.0, 0.0}, {_kro[i], _dKro[i], 0.0, 0.0}};
+    }
+
+    /**
+     * @brief Pontos de quebra: as saturações da tabela (vértices da interpolação).
+     */
+    std::vector<double> pontosDeQuebra() const override { return _sw; }
+
+    /**
+     * @brief Calcula Krw e Kro de um ponto com uma única busca do segmento.
+     * Definida em linha para ser expandida pela calculadora especializada.
+     * @param sw A saturação de água.
+     * @param krw Saída: o valor de Krw.
+     * @param kro Saída: o valor de Kro.
+     */
+    void calcularKrPonto(double sw, double& krw, double& kro) const override {
+        // Extrapolação de ponta (mesma regra de interpolar)
+        if (sw <= _sw.front()) {
+            krw = _krw.front();
+            kro = _kro.front();
+            return;
+        }
+        if (sw >= _sw.back()) {
+            krw = _krw.back();
+            kro = _kro.back();
+            return;
+        }
+        std::size_t i = localizarSegmento(sw);
+        double dx = sw - _sw[i];
+        if (!_cubica.empty()) {
+            avaliarCubica(_cubica[i], dx, krw, kro);
+            return;
+        }
+        krw = _krw[i] + dx * _dKrw[i];
+        kro = _kro[i] + dx * _dKro[i];
+    }
+
+    /**
+     * @brief Calcula Krw e Kro para um lote de saturações.
+     * O intervalo da tabela é localizado uma única vez por ponto e
+     * compartilhado pelas interpolações de Krw e Kro.
+     * @param sw Vetor de entrada com as saturações de água.
+     * @param krw Vetor de saída para Krw.
+     * @param kro Vetor de saída para Kro.
+     * @param n Número de saturações do lote.
+     */
+    void calcularKrLote(const double* sw, double* krw, double* kro, std::size_t n) const override;
+
+    /**
+     * @brief Calcula Krw, Kro e as derivadas para um lote.
+     * A derivada é a inclinação pré-calculada do segmento (à direita nos
+     * pontos da tabela), ou a derivada da cúbica no modo PCHIP, e zero fora
+     * da faixa tabelada.
+     * @param sw Vetor de entrada com as saturações de água.
+     * @param krw Vetor de saída para Krw.
+     * @param kro Vetor de saída para Kro.
+     * @param dkrw Vetor de saída para dKrw/dSw.
+     * @param dkro Vetor de saída para dKro/dSw.
+     * @param n Número de saturações do lote.
+     */
+    void calcularKrDerivadaLote(const double* sw, double* krw, double* kro,
+                                double* dkrw, double* dkro, std::size_t n) const override;
 };
 
+/**
+ * @brief Localiza o segmento que contém x (x dentro da tabela).
+ * Em linha no cabeçalho porque está no caminho de calcularKrPonto.
+ * @param x Saturação procurada.
+ * @return Índice i tal que _sw[i] <= x < _sw[i+1].
+ */
+inline std::size_t CurvasPermeabilidadeTabelada::localizarSegmento(double x) const {
+    // Busca binária: primeiro Sw estritamente maior que x, menos um
+    if (_indiceUniforme.empty()) {
+        return static_cast<std::size_t>(std::upper_bound(_sw.begin(), _sw.end(), x) - _sw.begin()) - 1;
+    }
+
+    // Índice uniforme: salta para o balde e anda o pouco que faltar
+    std::size_t b = static_cast<std::size_t>((x - _sw.front()) * _inversoLarguraBalde);
+    if (b >= _indiceUniforme.size()) {
+        b = _indiceUniforme.size() - 1;
+    }
+    std::size_t i = _indiceUniforme[b];
+    while (x >= _sw[i + 1]) {
+        ++i;
+    }
+    // Proteção contra o arredondamento no cálculo do balde
+    while (i > 0 && x < _sw[i]) {
+        --i;
+    }
+    return i;
+}
+
 #endif
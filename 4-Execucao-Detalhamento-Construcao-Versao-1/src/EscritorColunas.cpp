@@ -0,0 +1,165 @@
+#include "EscritorColunas.h"
+#include <algorithm> // Para std::min
+#include <charconv>  // Para std::to_chars
+#include <cstdint>
+#include <cstdio>    // Para std::FILE, std::fwrite
+#include <cstring>   // Para std::memcpy
+#include <stdexcept>
+
+namespace {
+
+/// Tamanho do buffer de escrita do CSV.
+const std::size_t TAMANHO_BUFFER = 1 << 20;
+
+/// Alinhamento do início de cada coluna no arquivo binário.
+const std::size_t ALINHAMENTO = 64;
+
+/// Tamanho do nome da coluna no cabeçalho binário (com o '\0').
+const std::size_t TAMANHO_NOME = 48;
+
+/**
+ * @brief Confere se todas as colunas têm o mesmo número de valores.
+ * @return O número de linhas.
+ */
+std::size_t numeroLinhas(const std::vector<ColunaSaida>& colunas, const std::string& arquivo) {
+    if (colunas.empty()) {
+        throw std::runtime_error("Erro: Nenhuma coluna para gravar em: " + arquivo);
+    }
+    std::size_t n = colunas.front().valores->size();
+    for (const ColunaSaida& c : colunas) {
+        if (c.valores->size() != n) {
+            throw std::runtime_error("Erro: Colunas de tamanhos diferentes em: " + arquivo);
+        }
+    }
+    return n;
+}
+
+/**
+ * @class ArquivoSaida
+ * @brief FILE* com fechamento automático e erro em falhas de escrita.
+ */
+class ArquivoSaida {
+private:
+    std::FILE* _arquivo;
+    std::string _nome;
+
+public:
+    explicit ArquivoSaida(const std::string& nome) : _arquivo(std::fopen(nome.c_str(), "wb")), _nome(nome) {
+        if (_arquivo == nullptr) {
+            throw std::runtime_error("Erro: Nao foi possivel criar o arquivo: " + nome);
+        }
+    }
+    ~ArquivoSaida() {
+        if (_arquivo != nullptr) {
+            std::fclose(_arquivo);
+        }
+    }
+    ArquivoSaida(const ArquivoSaida&) = delete;
+    ArquivoSaida& operator=(const ArquivoSaida&) = delete;
+
+    void escrever(const void* dados, std::size_t n) {
+        if (n > 0 && std::fwrite(dados, 1, n, _arquivo) != n) {
+            throw std::runtime_error("Erro: Falha ao gravar o arquivo: " + _nome);
+        }
+    }
+
+    void fechar() {
+        int r = std::fclose(_arquivo);
+        _arquivo = nullptr;
+        if (r != 0) {
+            throw std::runtime_error("Erro: Falha ao gravar o arquivo: " + _nome);
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Formata um double na menor representação de ida e volta exata.
+ * @param valor O número.
+ * @param destino Buffer de pelo menos 32 caracteres.
+ * @return Fim do texto.
+ */
+char* EscritorColunas::formatar(double valor, char* destino) {
+    return std::to_chars(destino, destino + 32, valor).ptr;
+}
+
+/**
+ * @brief Grava as colunas em CSV.
+ * @param arquivo O arquivo de saída.
+ * @param colunas As colunas.
+ */
+void EscritorColunas::salvarCsv(const std::string& arquivo, const std::vector<ColunaSaida>& colunas) {
+    const std::size_t n = numeroLinhas(colunas, arquivo);
+    ArquivoSaida saida(arquivo);
+
+    // 1. Cabeçalho
+    std::string buffer = "# ";
+    for (std::size_t k = 0; k < colunas.size(); ++k) {
+        buffer += (k == 0 ? "" : ", ") + colunas[k].nome;
+    }
+    buffer += '\n';
+    buffer.resize(TAMANHO_BUFFER);
+    std::size_t usado = buffer.find('\n') + 1;
+
+    // 2. Linhas; o buffer é descarregado quando não cabe mais uma linha
+    const std::size_t maiorLinha = colunas.size() * 34 + 1; // 32 dígitos + ", "
+    for (std::size_t i = 0; i < n; ++i) {
+        if (usado + maiorLinha > buffer.size()) {
+            saida.escrever(buffer.data(), usado);
+            usado = 0;
+        }
+        char* p = &buffer[usado];
+        for (std::size_t k = 0; k < colunas.size(); ++k) {
+            if (k > 0) {
+                *p++ = ',';
+                *p++ = ' ';
+            }
+            p = formatar((*colunas[k].valores)[i], p);
+        }
+        *p++ = '\n';
+        usado = static_cast<std::size_t>(p - buffer.data());
+    }
+    saida.escrever(buffer.data(), usado);
+    saida.fechar();
+}
+
+/**
+ * @brief Grava as colunas no formato binário colunar.
+ * @param arquivo O arquivo de saída.
+ * @param colunas As colunas.
+ */
+void EscritorColunas::salvarBinario(const std::string& arquivo, const std::vector<ColunaSaida>& colunas) {
+    const std::uint64_t n = numeroLinhas(colunas, arquivo);
+    const std::uint32_t nc = static_cast<std::uint32_t>(colunas.size());
+
+    // 1. Cabeçalho fixo e descritores das colunas
+    std::size_t tamanhoCabecalho = 32 + 64 * colunas.size();
+    std::size_t inicioDados = (tamanhoCabecalho + ALINHAMENTO - 1) / ALINHAMENTO * ALINHAMENTO;
+    std::size_t bytesColuna = static_cast<std::size_t>(n) * sizeof(double);
+    std::size_t passoColuna = (bytesColuna + ALINHAMENTO - 1) / ALINHAMENTO * ALINHAMENTO;
+
+    std::vector<unsigned char> cabecalho(inicioDados, 0);
+    const std::uint32_t ordemBytes = 0x01020304u;
+    std::memcpy(&cabecalho[0], "FWCOLS01", 8);
+    std::memcpy(&cabecalho[8], &ordemBytes, 4);
+    std::memcpy(&cabecalho[12], &nc, 4);
+    std::memcpy(&cabecalho[16], &n, 8);
+    for (std::size_t k = 0; k < colunas.size(); ++k) {
+        unsigned char* descritor = &cabecalho[32 + 64 * k];
+        std::size_t tamanhoNome = std::min(colunas[k].nome.size(), TAMANHO_NOME - 1);
+        std::memcpy(descritor, colunas[k].nome.data(), tamanhoNome);
+        std::uint64_t deslocamento = inicioDados + k * passoColuna;
+        std::memcpy(descritor + TAMANHO_NOME, &deslocamento, 8);
+    }
+
+    // 2. Dados: cada coluna inteira numa escrita, com preenchimento até o alinhamento
+    ArquivoSaida saida(arquivo);
+    saida.escrever(cabecalho.data(), cabecalho.size());
+    const unsigned char zeros[ALINHAMENTO] = {};
+    for (const ColunaSaida& c : colunas) {
+        saida.escrever(c.valores->data(), bytesColuna);
+        saida.escrever(zeros, passoColuna - bytesColuna);
+    }
+    saida.fechar();
+}
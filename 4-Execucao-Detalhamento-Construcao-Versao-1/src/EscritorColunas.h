@@ -0,0 +1,72 @@
+#ifndef ESCRITORCOLUNAS_H
+#define ESCRITORCOLUNAS_H
+
+#include <string>
+#include <vector>
+#include <cstddef> // Para std::size_t
+
+/**
+ * @struct ColunaSaida
+ * @brief Uma coluna de números a gravar (não copia os dados).
+ */
+struct ColunaSaida {
+    /// Nome da coluna (cabeçalho do CSV ou do arquivo binário).
+    std::string nome;
+
+    /// Valores da coluna.
+    const std::vector<double>* valores;
+};
+
+/**
+ * @class EscritorColunas
+ * @brief Gravação rápida e sem perda de séries numéricas (curvas, previsões, perfis).
+ *
+ * Dois formatos, ambos com todas as colunas do mesmo tamanho:
+ *
+ * - CSV: cabeçalho "# nome1, nome2, ..." e valores separados por ", ",
+ *   formatados com std::to_chars na menor representação que relê o mesmo
+ *   double (ida e volta exata, ao contrário dos 6 dígitos do operator<<).
+ *   O texto é montado num buffer de 1 MiB e gravado em blocos.
+ *
+ * - Binário colunar (extensão .bin), feito para ser mapeado em memória:
+ *   @code
+ *   deslocamento  conteúdo
+ *   0             "FWCOLS01" (assinatura e versão, 8 bytes)
+ *   8             uint32 0x01020304 (confere a ordem dos bytes)
+ *   12            uint32 número de colunas (nc)
+ *   16            uint64 número de linhas (nl)
+ *   24            uint64 reservado (0)
+ *   32 + 64*k     coluna k: nome (48 bytes, terminado em '\0'),
+ *                 uint64 deslocamento dos dados, uint64 reservado
+ *   ...           dados de cada coluna: nl doubles IEEE-754 contíguos,
+ *                 na ordem de bytes da máquina, início alinhado em 64 bytes
+ *   @endcode
+ *   Um leitor só precisa mapear o arquivo e apontar para o deslocamento
+ *   de cada coluna (ex: numpy.memmap).
+ */
+class EscritorColunas {
+public:
+    /**
+     * @brief Grava as colunas num arquivo CSV.
+     * @param arquivo O caminho do arquivo.
+     * @param colunas As colunas (mesmo número de valores).
+     */
+    static void salvarCsv(const std::string& arquivo, const std::vector<ColunaSaida>& colunas);
+
+    /**
+     * @brief Grava as colunas no formato binário colunar.
+     * @param arquivo O caminho do arquivo.
+     * @param colunas As colunas (mesmo número de valores).
+     */
+    static void salvarBinario(const std::string& arquivo, const std::vector<ColunaSaida>& colunas);
+
+    /**
+     * @brief Formata um double na menor representação de ida e volta exata.
+     * @param valor O número.
+     * @param destino Buffer de pelo menos 32 caracteres.
+     * @return Ponteiro para o fim do texto escrito.
+     */
+    static char* formatar(double valor, char* destino);
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef EXPOENTECOREY_H
+#define EXPOENTECOREY_H
+
+#include <cmath> // Para std::pow, std::sqrt e std::floor
+
+/**
+ * @struct ExpoenteCorey
+ * @brief Expoente de Corey classificado para escolher o cálculo da potência.
+ *
+ * A maioria dos decks usa expoentes inteiros (2, 3, 4) ou semi-inteiros
+ * (1.5, 2.5). Para eles x^n é calculado por multiplicações repetidas
+ * (exponenciação binária) e, no caso semi-inteiro, mais uma raiz quadrada,
+ * bem mais barato que std::pow. A classificação é feita uma vez, quando os
+ * parâmetros do modelo são definidos; os demais expoentes usam std::pow.
+ */
+struct ExpoenteCorey {
+    /// Forma do expoente.
+    enum class Forma { Geral, Inteiro, SemiInteiro };
+
+    /// Maior parte inteira com caminho especializado (acima disso, std::pow).
+    static constexpr unsigned MAIOR_PARTE_INTEIRA = 16;
+
+    /// Forma detectada (Geral = std::pow).
+    Forma forma = Forma::Geral;
+
+    /// Parte inteira k do expoente (n = k ou n = k + 1/2).
+    unsigned parteInteira = 0;
+
+    /// O expoente original.
+    double expoente = 0.0;
+
+    /**
+     * @brief Classifica um expoente.
+     * @param n O expoente de Corey (n >= 0).
+     * @return A forma detectada e a parte inteira.
+     */
+    static ExpoenteCorey classificar(double n) {
+        ExpoenteCorey e;
+        e.expoente = n;
+        if (!(n >= 0.0) || n > MAIOR_PARTE_INTEIRA + 0.5) {
+            return e;
+        }
+        double k = std::floor(n);
+        if (n == k) {
+            e.forma = Forma::Inteiro;
+        } else if (n - k == 0.5) {
+            e.forma = Forma::SemiInteiro;
+        } else {
+            return e;
+        }
+        e.parteInteira = static_cast<unsigned>(k);
+        return e;
+    }
+
+    /**
+     * @brief x^k por exponenciação binária (no máximo 2*log2(k) + 1 multiplicações).
+     * @param x A base.
+     * @param k O expoente inteiro.
+     * @return x^k (1 para k = 0).
+     */
+    static double potenciaInteira(double x, unsigned k) {
+        double resultado = 1.0;
+        while (k != 0) {
+            if (k & 1u) {
+                resultado *= x;
+            }
+            x *= x;
+            k >>= 1;
+        }
+        return resultado;
+    }
+
+    /**
+     * @brief Calcula x^n com o caminho escolhido na classificação.
+     * @param x A base, em [0, 1].
+     * @return x elevado ao expoente.
+     */
+    double aplicar(double x) const {
+        switch (forma) {
+            case Forma::Inteiro:     return potenciaInteira(x, parteInteira);
+            case Forma::SemiInteiro: return potenciaInteira(x, parteInteira) * std::sqrt(x);
+            default:                 return std::pow(x, expoente);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef GERADORPHILOX_H
+#define GERADORPHILOX_H
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @class GeradorPhilox
+ * @brief Gerador de números aleatórios baseado em contador (Philox4x32-10).
+ *
+ * Em vez de um estado que avança a cada sorteio, cada bloco de 4 inteiros
+ * de 32 bits é uma função pura de (chave, contador): 10 rodadas de
+ * multiplicação 32x32->64 e XOR (Salmon et al., "Parallel random numbers:
+ * as easy as 1, 2, 3", SC'11). Usando como contador o número da realização
+ * e do parâmetro, cada amostra é a mesma em qualquer thread e em qualquer
+ * ordem de execução, sem fluxos por thread a sincronizar.
+ */
+class GeradorPhilox {
+private:
+    /// Chave (derivada da semente).
+    std::uint32_t _chave0;
+    std::uint32_t _chave1;
+
+public:
+    /// Um bloco de 4 palavras (contador ou saída).
+    using Bloco = std::array<std::uint32_t, 4>;
+
+    /**
+     * @brief Construtor.
+     * @param semente Semente de 64 bits (vira a chave de 2x32 bits).
+     */
+    explicit GeradorPhilox(std::uint64_t semente)
+    : _chave0(static_cast<std::uint32_t>(semente)), _chave1(static_cast<std::uint32_t>(semente >> 32)) {}
+
+    /**
+     * @brief Aplica as 10 rodadas do Philox4x32 a um contador.
+     * @param contador O contador de 128 bits.
+     * @return 128 bits pseudoaleatórios.
+     */
+    Bloco gerar(Bloco contador) const {
+        std::uint32_t k0 = _chave0;
+        std::uint32_t k1 = _chave1;
+        for (int rodada = 0; rodada < 10; ++rodada) {
+            std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * contador[0];
+            std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * contador[2];
+            contador = Bloco{static_cast<std::uint32_t>(p1 >> 32) ^ contador[1] ^ k0,
+                             static_cast<std::uint32_t>(p1),
+                             static_cast<std::uint32_t>(p0 >> 32) ^ contador[3] ^ k1,
+                             static_cast<std::uint32_t>(p0)};
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        return contador;
+    }
+
+    /**
+     * @brief Dois uniformes em (0, 1) para o par (índice, fluxo).
+     * Cada uniforme usa 53 bits da saída (resolução de um double).
+     * @param indice Índice da realização.
+     * @param fluxo Fluxo independente dentro da realização (ex: o parâmetro).
+     * @param u1 Primeiro uniforme.
+     * @param u2 Segundo uniforme.
+     */
+    void uniformes(std::uint64_t indice, std::uint32_t fluxo, double& u1, double& u2) const {
+        Bloco r = gerar(Bloco{static_cast<std::uint32_t>(indice), static_cast<std::uint32_t>(indice >> 32), fluxo, 0u});
+        const double escala = 1.0 / 9007199254740992.0; // 2^-53
+        std::uint64_t a = (static_cast<std::uint64_t>(r[0]) << 21) ^ (r[1] >> 11);
+        std::uint64_t b = (static_cast<std::uint64_t>(r[2]) << 21) ^ (r[3] >> 11);
+        u1 = (static_cast<double>(a) + 0.5) * escala; // centro do intervalo: nunca 0 nem 1
+        u2 = (static_cast<double>(b) + 0.5) * escala;
+    }
+};
+
+#endif
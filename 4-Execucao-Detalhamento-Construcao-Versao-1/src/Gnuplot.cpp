@@ -1,50 +1,200 @@
 #include "Gnuplot.h"
+#include "EscritorColunas.h"
+#include <filesystem>
 #include <iostream>
-#include <fstream>
-#include <cstdlib> // Para system()
+#include <sstream>
+#include <stdexcept>
+#include <utility>  // Para std::move
 
-// TODO: Documentar com JAVADOC/Doxygen
-void Gnuplot::plotarCurva(const std::map<double, double>& dados, const std::string& titulo) {
-    std::cout << "DEBUG: Chamando Gnuplot...\n";
+#if defined(_WIN32)
+#define popen _popen
+#define pclose _pclose
+#else
+#include <csignal>  // Para ignorar SIGPIPE
+#endif
 
-    // Nomes dos arquivos temporários
-    std::string tempDados = "temp_data.csv";
-    std::string tempScript = "temp_script.gp";
+namespace {
 
-    // --- 1. Salvar dados no arquivo .csv ---
-    std::ofstream arqDados(tempDados);
-    if (!arqDados.is_open()) {
-        std::cerr << "Erro: Nao foi possivel criar arquivo de dados temporario.\n";
-        return;
+/**
+ * @brief Escapa aspas simples para uma string entre aspas simples do gnuplot.
+ */
+std::string escaparAspas(const std::string& texto) {
+    std::string saida;
+    saida.reserve(texto.size());
+    for (char c : texto) {
+        saida += c;
+        if (c == '\'') {
+            saida += '\''; // '' dentro de '...' é uma aspa literal
+        }
+    }
+    return saida;
+}
+
+} // namespace
+
+/**
+ * @brief Retorna a instância única (o processo gnuplot é aberto sob demanda).
+ */
+Gnuplot& Gnuplot::instancia() {
+    static Gnuplot gnuplot;
+    return gnuplot;
+}
+
+/**
+ * @brief Encerra a thread de escrita e fecha o pipe.
+ * O pclose espera o gnuplot ler tudo; com -persist as janelas continuam abertas.
+ */
+Gnuplot::~Gnuplot() {
+    {
+        std::lock_guard<std::mutex> trava(_mutex);
+        _encerrar = true;
+    }
+    _temScript.notify_one();
+    if (_escritor.joinable()) {
+        _escritor.join();
     }
-    arqDados << "# Sw, Fw\n";
-    for (const auto& par : dados) {
-        arqDados << par.first << ", " << par.second << "\n";
+    if (_pipe != nullptr) {
+        pclose(_pipe);
     }
-    arqDados.close();
+}
 
-    // --- 2. Criar script do Gnuplot ---
-    std::ofstream arqScript(tempScript);
-    if (!arqScript.is_open()) {
-        std::cerr << "Erro: Nao foi possivel criar script Gnuplot temporario.\n";
+/**
+ * @brief Põe um script na fila; na primeira chamada abre o gnuplot e a thread de escrita.
+ * @param script Comandos do gnuplot.
+ */
+void Gnuplot::enviar(std::string script) {
+    std::lock_guard<std::mutex> trava(_mutex);
+    if (_falhou) {
         return;
     }
-    arqScript << "set title '" << titulo << "'\n";
-    arqScript << "set xlabel 'Saturacao de Agua (Sw)'\n";
-    arqScript << "set ylabel 'Fluxo Fracionario de Agua (Fw)'\n";
-    arqScript << "set grid\n";
-    arqScript << "set key top left\n";
-    arqScript << "set datafile separator ','\n";
-    arqScript << "plot '" << tempDados << "' with lines title 'Curva Fw'\n";
-    arqScript << "pause -1 'Pressione Enter para fechar'\n"; // Mantém a janela aberta
-    arqScript.close();
-
-    // --- 3. Executar Gnuplot ---
-    // Este comando supõe que 'gnuplot' está no PATH do sistema
-    std::string comando = "gnuplot " + tempScript;
-    std::system(comando.c_str());
-
-    // --- 4. (Opcional) Limpar arquivos temporários ---
-    // std::remove(tempDados.c_str());
-    // std::remove(tempScript.c_str());
+
+    if (_pipe == nullptr) {
+#if !defined(_WIN32)
+        // Sem isso, escrever num gnuplot que terminou mataria o programa com SIGPIPE
+        std::signal(SIGPIPE, SIG_IGN);
+#endif
+        _pipe = popen("gnuplot -persist", "w");
+        if (_pipe == nullptr) {
+            _falhou = true;
+            std::cerr << "Aviso: Nao foi possivel abrir o gnuplot; graficos desativados.\n";
+            return;
+        }
+        _escritor = std::thread(&Gnuplot::escrever, this);
+    }
+
+    _fila.push_back(std::move(script));
+    _temScript.notify_one();
+}
+
+/**
+ * @brief Laço da thread de escrita.
+ */
+void Gnuplot::escrever() {
+    std::unique_lock<std::mutex> trava(_mutex);
+    while (true) {
+        _temScript.wait(trava, [this] { return _encerrar || !_fila.empty(); });
+        if (_fila.empty()) {
+            return; // encerrar, sem nada pendente
+        }
+        std::string script = std::move(_fila.front());
+        _fila.pop_front();
+
+        // A escrita (que pode bloquear no pipe) é feita fora da trava
+        trava.unlock();
+        bool ok = std::fwrite(script.data(), 1, script.size(), _pipe) == script.size() && std::fflush(_pipe) == 0;
+        trava.lock();
+
+        if (!ok && !_falhou) {
+            _falhou = true;
+            _fila.clear();
+            std::cerr << "Aviso: O gnuplot nao esta disponivel (pipe fechado); graficos desativados.\n";
+        }
+    }
+}
+
+/**
+ * @brief Monta o bloco de dados embutido e os comandos do gráfico.
+ * @param curva A curva de fluxo fracionário.
+ * @param titulo O título do gráfico.
+ * @return O script.
+ */
+std::string Gnuplot::scriptCurva(const CurvaFluxoFracionario& curva, const std::string& titulo) {
+    // --- 1. Bloco de dados embutido (to_chars: sem perda e sem o custo do operator<<) ---
+    std::ostringstream script;
+    std::string dados = "$DADOS << EOD\n";
+    dados.reserve(dados.size() + 50 * curva.tamanho() + 4);
+    const std::vector<double>& sw = curva.sw();
+    const std::vector<double>& fw = curva.fw();
+    char linha[80];
+    for (std::size_t i = 0; i < curva.tamanho(); ++i) {
+        char* p = EscritorColunas::formatar(sw[i], linha);
+        *p++ = ' ';
+        p = EscritorColunas::formatar(fw[i], p);
+        *p++ = '\n';
+        dados.append(linha, static_cast<std::size_t>(p - linha));
+    }
+    dados += "EOD\n";
+    script << dados;
+
+    // --- 2. Comandos do gráfico ---
+    script << "set title '" << escaparAspas(titulo) << "'\n";
+    script << "set xlabel 'Saturacao de Agua (Sw)'\n";
+    script << "set ylabel 'Fluxo Fracionario de Agua (Fw)'\n";
+    script << "set grid\n";
+    script << "set key top left\n";
+    script << "plot $DADOS with lines title 'Curva Fw'\n";
+    return script.str();
+}
+
+/**
+ * @brief Plota a curva (Sw, Fw) na janela do gnuplot.
+ * @param curva A curva de fluxo fracionário.
+ * @param titulo O título do gráfico.
+ */
+void Gnuplot::plotarCurva(const CurvaFluxoFracionario& curva, const std::string& titulo) {
+    // Envio assíncrono ao processo compartilhado
+    instancia().enviar(scriptCurva(curva, titulo));
+}
+
+/**
+ * @brief Grava a curva num arquivo PNG ou SVG (terminal de arquivo do gnuplot).
+ * Usa um processo gnuplot próprio, fechado e conferido antes de retornar.
+ * @param curva A curva de fluxo fracionário.
+ * @param titulo O título do gráfico.
+ * @param arquivo O arquivo de saída (.png ou .svg).
+ */
+void Gnuplot::salvarCurva(const CurvaFluxoFracionario& curva, const std::string& titulo, const std::string& arquivo) {
+    std::string extensao = arquivo.size() >= 4 ? arquivo.substr(arquivo.size() - 4) : "";
+    std::string terminal;
+    if (extensao == ".png") {
+        terminal = "if (strstrt(GPVAL_TERMINALS, 'pngcairo') > 0) { set terminal pngcairo size 800,600 } "
+                   "else { set terminal png size 800,600 }\n";
+    } else if (extensao == ".svg") {
+        terminal = "set terminal svg size 800,600\n";
+    } else {
+        throw std::runtime_error("Erro: Formato de grafico nao suportado (use .png ou .svg): " + arquivo);
+    }
+    std::string script = terminal + "set output '" + escaparAspas(arquivo) + "'\n" + scriptCurva(curva, titulo)
+                         + "unset output\n";
+
+    // 1. Um arquivo antigo com o mesmo nome não pode passar por resultado
+    std::error_code erro;
+    std::filesystem::remove(arquivo, erro);
+
+#if !defined(_WIN32)
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    // 2. Processo próprio, sem -persist: o pclose espera o arquivo ser fechado
+    FILE* pipe = popen("gnuplot", "w");
+    if (pipe == nullptr) {
+        throw std::runtime_error("Erro: Nao foi possivel executar o gnuplot para gravar " + arquivo + ".");
+    }
+    bool escreveu = std::fwrite(script.data(), 1, script.size(), pipe) == script.size();
+    int status = pclose(pipe);
+
+    // 3. Conferir o término do gnuplot e o arquivo gerado
+    if (!escreveu || status != 0 || std::filesystem::file_size(arquivo, erro) == 0 || erro) {
+        throw std::runtime_error("Erro: O gnuplot nao gerou o grafico " + arquivo + " (o gnuplot esta instalado?).");
+    }
 }
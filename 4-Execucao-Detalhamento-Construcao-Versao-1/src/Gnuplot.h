@@ -1,26 +1,116 @@
 #ifndef GNUPLOT_H
 #define GNUPLOT_H
 
-#include <map>
+#include "CurvaFluxoFracionario.h"
+#include <condition_variable>
+#include <cstdio>  // Para FILE
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 
 /**
  * @class Gnuplot
  * @brief Classe utilitária que implementa o Padrão de Projeto Facade.
  *
- * Esta classe esconde toda a complexidade de lidar com o Gnuplot
- * (criar arquivos temporários, formatar scripts, chamar o system())
- * por trás de um único método estático.
+ * Esta classe esconde toda a complexidade de lidar com o Gnuplot por trás
+ * de um único método estático. Um único processo gnuplot é aberto (por
+ * pipe, na primeira plotagem) e reaproveitado por todas as plotagens do
+ * programa. Os dados vão dentro do próprio script, num bloco de dados
+ * ($DADOS << EOD), sem arquivos temporários no diretório de trabalho.
+ *
+ * A plotagem em janela não bloqueia quem a chama: o script é montado e
+ * posto numa fila, e uma thread de escrita o envia ao gnuplot. As janelas
+ * ficam abertas (-persist) depois que o programa termina. Se o gnuplot não
+ * puder ser executado, um aviso é emitido uma vez e as plotagens
+ * seguintes são descartadas, sem interromper o cálculo.
+ *
+ * A gravação em arquivo (salvarCurva) é síncrona: abre um gnuplot só para
+ * aquele gráfico, espera-o terminar e lança um erro se o arquivo não foi
+ * gerado, em vez de anunciar um arquivo que não existirá.
  */
 class Gnuplot {
+private:
+    /// Pipe para a entrada padrão do gnuplot (nulo até a primeira plotagem).
+    FILE* _pipe = nullptr;
+
+    /// Thread que escreve os scripts no pipe.
+    std::thread _escritor;
+
+    /// Protege a fila e os indicadores abaixo.
+    std::mutex _mutex;
+
+    /// Sinaliza scripts na fila ou pedido de encerramento.
+    std::condition_variable _temScript;
+
+    /// Scripts aguardando envio.
+    std::deque<std::string> _fila;
+
+    /// Pedido de encerramento da thread de escrita.
+    bool _encerrar = false;
+
+    /// Indica que o gnuplot não pôde ser aberto ou o pipe foi fechado.
+    bool _falhou = false;
+
+    /**
+     * @brief Construtor privado (instância única, ver instancia()).
+     */
+    Gnuplot() = default;
+
+    /**
+     * @brief Envia os scripts pendentes, fecha o pipe e espera o gnuplot.
+     */
+    ~Gnuplot();
+
+    Gnuplot(const Gnuplot&) = delete;
+    Gnuplot& operator=(const Gnuplot&) = delete;
+
+    /**
+     * @brief Laço da thread de escrita: retira scripts da fila e os envia ao pipe.
+     */
+    void escrever();
+
+    /**
+     * @brief Põe um script na fila, abrindo o gnuplot na primeira chamada.
+     * @param script Comandos do gnuplot (com os dados embutidos).
+     */
+    void enviar(std::string script);
+
+    /**
+     * @brief Instância única, criada na primeira plotagem.
+     */
+    static Gnuplot& instancia();
+
+    /**
+     * @brief Monta o bloco de dados e os comandos de plotagem de uma curva.
+     * @param curva A curva de fluxo fracionário.
+     * @param titulo O título do gráfico.
+     * @return O script (sem seleção de terminal).
+     */
+    static std::string scriptCurva(const CurvaFluxoFracionario& curva, const std::string& titulo);
+
 public:
     /**
-     * @brief Plota um mapa de dados (x, y) usando o Gnuplot.
-     * Este é um método estático, pois não precisa de um estado de instância.
-     * @param dados Um std::map<double, double> onde a chave é o eixo X (Sw) e o valor é o eixo Y (Fw).
+     * @brief Plota uma curva (Sw, Fw) usando o Gnuplot.
+     * Este é um método estático, pois o processo do gnuplot é compartilhado.
+     * Retorna assim que o script é posto na fila (não espera o gnuplot).
+     * @param curva A curva de fluxo fracionário (eixo X: Sw, eixo Y: Fw).
      * @param titulo O título que aparecerá no topo do gráfico.
      */
-    static void plotarCurva(const std::map<double, double>& dados, const std::string& titulo);
+    static void plotarCurva(const CurvaFluxoFracionario& curva, const std::string& titulo);
+
+    /**
+     * @brief Grava a curva num arquivo PNG ou SVG pelos terminais de arquivo do gnuplot.
+     * Não abre janela nem espera interação (próprio para nós sem interface
+     * gráfica). O terminal é escolhido pela extensão (.png: pngcairo, ou png
+     * se o cairo não existir; .svg: svg). Ao contrário de plotarCurva, usa
+     * um processo gnuplot próprio e só retorna com o arquivo gravado.
+     * @param curva A curva de fluxo fracionário.
+     * @param titulo O título do gráfico.
+     * @param arquivo O caminho do arquivo (.png ou .svg).
+     * @throws std::runtime_error Se o gnuplot não puder ser executado ou não gerar o arquivo.
+     */
+    static void salvarCurva(const CurvaFluxoFracionario& curva, const std::string& titulo, const std::string& arquivo);
 };
 
 #endif
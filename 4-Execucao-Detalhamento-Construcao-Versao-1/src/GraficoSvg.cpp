@@ -0,0 +1,150 @@
+#include "GraficoSvg.h"
+#include <algorithm> // Para std::minmax_element
+#include <cmath>     // Para std::floor, std::log10, std::pow
+#include <cstdio>    // Para std::snprintf
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+/// Dimensões do desenho e margens da área do gráfico (pixels).
+const double LARGURA = 800.0;
+const double ALTURA = 600.0;
+const double MARGEM_ESQUERDA = 80.0;
+const double MARGEM_DIREITA = 30.0;
+const double MARGEM_TOPO = 50.0;
+const double MARGEM_BASE = 60.0;
+
+/**
+ * @brief Passo "redondo" (1, 2 ou 5 x 10^k) para cerca de 5 marcas na faixa.
+ */
+double passoMarcas(double faixa) {
+    double bruto = faixa / 5.0;
+    double potencia = std::pow(10.0, std::floor(std::log10(bruto)));
+    double r = bruto / potencia;
+    return potencia * (r < 1.5 ? 1.0 : r < 3.5 ? 2.0 : r < 7.5 ? 5.0 : 10.0);
+}
+
+/**
+ * @brief Escapa os caracteres especiais do XML.
+ */
+std::string escaparXml(const std::string& texto) {
+    std::string saida;
+    for (char c : texto) {
+        switch (c) {
+            case '&': saida += "&amp;"; break;
+            case '<': saida += "&lt;"; break;
+            case '>': saida += "&gt;"; break;
+            case '"': saida += "&quot;"; break;
+            default:  saida += c;
+        }
+    }
+    return saida;
+}
+
+/**
+ * @brief Acrescenta um texto formatado (printf) ao documento.
+ */
+template <typename... Args>
+void acrescentar(std::string& doc, const char* formato, Args... args) {
+    char buffer[256];
+    int n = std::snprintf(buffer, sizeof(buffer), formato, args...);
+    doc.append(buffer, static_cast<std::size_t>(std::min(n, static_cast<int>(sizeof(buffer)) - 1)));
+}
+
+} // namespace
+
+/**
+ * @brief Grava a curva num arquivo SVG.
+ * @param curva A curva de fluxo fracionário.
+ * @param titulo O título do gráfico.
+ * @param arquivo O arquivo de saída.
+ */
+void GraficoSvg::salvarCurva(const CurvaFluxoFracionario& curva, const std::string& titulo, const std::string& arquivo) {
+    if (curva.vazia()) {
+        throw std::runtime_error("Erro: Curva vazia nao pode ser plotada: " + arquivo);
+    }
+    const std::vector<double>& sw = curva.sw();
+    const std::vector<double>& fw = curva.fw();
+
+    // --- 1. Faixas dos eixos, estendidas até marcas redondas ---
+    auto [xMin, xMax] = std::minmax_element(sw.begin(), sw.end());
+    auto [yMin, yMax] = std::minmax_element(fw.begin(), fw.end());
+    double x0 = *xMin, x1 = *xMax, y0 = std::min(*yMin, 0.0), y1 = std::max(*yMax, 1.0);
+    if (x1 <= x0) {
+        x1 = x0 + 1.0;
+    }
+    double passoX = passoMarcas(x1 - x0);
+    double passoY = passoMarcas(y1 - y0);
+    x0 = std::floor(x0 / passoX + 1e-9) * passoX;
+    x1 = std::ceil(x1 / passoX - 1e-9) * passoX;
+    y0 = std::floor(y0 / passoY + 1e-9) * passoY;
+    y1 = std::ceil(y1 / passoY - 1e-9) * passoY;
+
+    const double larguraArea = LARGURA - MARGEM_ESQUERDA - MARGEM_DIREITA;
+    const double alturaArea = ALTURA - MARGEM_TOPO - MARGEM_BASE;
+    auto px = [&](double x) { return MARGEM_ESQUERDA + (x - x0) / (x1 - x0) * larguraArea; };
+    auto py = [&](double y) { return MARGEM_TOPO + (y1 - y) / (y1 - y0) * alturaArea; };
+
+    std::string doc;
+    doc.reserve(4096 + 24 * curva.tamanho());
+
+    // --- 2. Cabeçalho, fundo e título ---
+    acrescentar(doc, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                     "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.0f\" height=\"%.0f\" "
+                     "viewBox=\"0 0 %.0f %.0f\" font-family=\"sans-serif\" font-size=\"13\">\n",
+                LARGURA, ALTURA, LARGURA, ALTURA);
+    acrescentar(doc, "<rect width=\"100%%\" height=\"100%%\" fill=\"white\"/>\n");
+    doc += "<text x=\"" + std::to_string(static_cast<int>(LARGURA / 2)) + "\" y=\"30\" text-anchor=\"middle\" font-size=\"16\">"
+         + escaparXml(titulo) + "</text>\n";
+
+    // --- 3. Grade e marcas ---
+    doc += "<g stroke=\"#dddddd\" stroke-width=\"1\">\n";
+    int nx = static_cast<int>(std::lround((x1 - x0) / passoX));
+    int ny = static_cast<int>(std::lround((y1 - y0) / passoY));
+    for (int i = 0; i <= nx; ++i) {
+        double x = px(x0 + i * passoX);
+        acrescentar(doc, "<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"/>\n", x, MARGEM_TOPO, x, ALTURA - MARGEM_BASE);
+    }
+    for (int j = 0; j <= ny; ++j) {
+        double y = py(y0 + j * passoY);
+        acrescentar(doc, "<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"/>\n", MARGEM_ESQUERDA, y, LARGURA - MARGEM_DIREITA, y);
+    }
+    doc += "</g>\n<g text-anchor=\"middle\">\n";
+    for (int i = 0; i <= nx; ++i) {
+        acrescentar(doc, "<text x=\"%.2f\" y=\"%.2f\">%g</text>\n", px(x0 + i * passoX), ALTURA - MARGEM_BASE + 18, x0 + i * passoX);
+    }
+    doc += "</g>\n<g text-anchor=\"end\">\n";
+    for (int j = 0; j <= ny; ++j) {
+        acrescentar(doc, "<text x=\"%.2f\" y=\"%.2f\">%g</text>\n", MARGEM_ESQUERDA - 8, py(y0 + j * passoY) + 4, y0 + j * passoY);
+    }
+    doc += "</g>\n";
+
+    // --- 4. Moldura e rótulos dos eixos ---
+    acrescentar(doc, "<rect x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\" fill=\"none\" stroke=\"black\"/>\n",
+                MARGEM_ESQUERDA, MARGEM_TOPO, larguraArea, alturaArea);
+    acrescentar(doc, "<text x=\"%.2f\" y=\"%.2f\" text-anchor=\"middle\">Saturacao de Agua (Sw)</text>\n",
+                MARGEM_ESQUERDA + larguraArea / 2, ALTURA - 15);
+    acrescentar(doc, "<text transform=\"translate(20 %.2f) rotate(-90)\" text-anchor=\"middle\">Fluxo Fracionario de Agua (Fw)</text>\n",
+                MARGEM_TOPO + alturaArea / 2);
+
+    // --- 5. Curva ---
+    doc += "<polyline fill=\"none\" stroke=\"#1f77b4\" stroke-width=\"2\" points=\"";
+    for (std::size_t i = 0; i < curva.tamanho(); ++i) {
+        acrescentar(doc, "%.2f,%.2f ", px(sw[i]), py(fw[i]));
+    }
+    doc += "\"/>\n";
+    acrescentar(doc, "<text x=\"%.2f\" y=\"%.2f\" fill=\"#1f77b4\">Curva Fw</text>\n", MARGEM_ESQUERDA + 10, MARGEM_TOPO + 20);
+    doc += "</svg>\n";
+
+    // --- 6. Gravação única ---
+    std::ofstream saida(arquivo, std::ios::binary);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro: Nao foi possivel criar o arquivo do grafico: " + arquivo);
+    }
+    saida.write(doc.data(), static_cast<std::streamsize>(doc.size()));
+    saida.close(); // o close esvazia o buffer: um disco cheio aparece aqui
+    if (!saida) {
+        throw std::runtime_error("Erro: Falha ao gravar o arquivo: " + arquivo);
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef GRAFICOSVG_H
+#define GRAFICOSVG_H
+
+#include "CurvaFluxoFracionario.h"
+#include <string>
+
+/**
+ * @class GraficoSvg
+ * @brief Gerador próprio de gráficos SVG, sem processo externo.
+ *
+ * Desenha eixos, grade, marcas com valores "redondos" (1, 2 ou 5 x 10^k),
+ * título e a curva como uma polyline. O documento é montado em memória e
+ * gravado de uma vez. Não há estado compartilhado: várias threads podem
+ * gerar gráficos ao mesmo tempo (ex: milhares de casos em lote num nó
+ * sem interface gráfica).
+ */
+class GraficoSvg {
+public:
+    /**
+     * @brief Grava a curva (Sw, Fw) num arquivo SVG.
+     * @param curva A curva de fluxo fracionário.
+     * @param titulo O título do gráfico.
+     * @param arquivo O caminho do arquivo .svg.
+     */
+    static void salvarCurva(const CurvaFluxoFracionario& curva, const std::string& titulo, const std::string& arquivo);
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include "HistogramaQuantis.h"
+#include <algorithm> // Para std::min e std::max
+#include <cmath>     // Para std::ceil
+#include <limits>    // Para std::numeric_limits
+#include <stdexcept>
+
+/**
+ * @brief Construtor: aloca as contagens zeradas.
+ * @param nSeries Número de séries.
+ * @param nBaldes Número de baldes por série.
+ * @param minimo Limite inferior da faixa.
+ * @param maximo Limite superior da faixa.
+ */
+HistogramaQuantis::HistogramaQuantis(std::size_t nSeries, std::size_t nBaldes, double minimo, double maximo)
+: _nSeries(nSeries), _nBaldes(nBaldes), _minimo(minimo), _maximo(maximo), _escala(0.0),
+  _contagem(nSeries * nBaldes, 0), _total(nSeries, 0), _abaixo(nSeries, 0), _acima(nSeries, 0),
+  _menor(nSeries, std::numeric_limits<double>::infinity()), _maior(nSeries, -std::numeric_limits<double>::infinity()) {
+    if (nBaldes == 0 || !(maximo > minimo)) {
+        throw std::runtime_error("Erro: Histograma precisa de baldes e de uma faixa com maximo > minimo.");
+    }
+    _escala = static_cast<double>(nBaldes) / (maximo - minimo);
+}
+
+/**
+ * @brief Soma as contagens de outro histograma.
+ * @param outro Histograma com a mesma forma.
+ */
+void HistogramaQuantis::juntar(const HistogramaQuantis& outro) {
+    if (outro._nSeries != _nSeries || outro._nBaldes != _nBaldes) {
+        throw std::runtime_error("Erro: Histogramas com formas diferentes nao podem ser juntados.");
+    }
+    for (std::size_t i = 0; i < _contagem.size(); ++i) {
+        _contagem[i] += outro._contagem[i];
+    }
+    for (std::size_t s = 0; s < _nSeries; ++s) {
+        _total[s] += outro._total[s];
+        _abaixo[s] += outro._abaixo[s];
+        _acima[s] += outro._acima[s];
+        _menor[s] = std::min(_menor[s], outro._menor[s]);
+        _maior[s] = std::max(_maior[s], outro._maior[s]);
+    }
+}
+
+/**
+ * @brief Estima um quantil por interpolação linear dentro do balde.
+ * @param serie Índice da série.
+ * @param p Probabilidade em [0, 1].
+ * @return O quantil estimado.
+ */
+double HistogramaQuantis::quantil(std::size_t serie, double p) const {
+    std::uint64_t total = _total[serie];
+    if (total == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // 1. Posição do quantil na amostra ordenada (1 .. total)
+    double alvo = std::max(1.0, std::ceil(p * static_cast<double>(total)));
+
+    // Posições ocupadas por amostras fora da faixa: o valor não é conhecido
+    if (alvo <= static_cast<double>(_abaixo[serie]) || alvo > static_cast<double>(total - _acima[serie])) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // 2. Balde onde a contagem acumulada (a partir das amostras abaixo) alcança a posição
+    const std::uint32_t* c = &_contagem[serie * _nBaldes];
+    std::uint64_t acumulado = _abaixo[serie];
+    std::size_t b = 0;
+    for (; b < _nBaldes; ++b) {
+        if (static_cast<double>(acumulado + c[b]) >= alvo) {
+            break;
+        }
+        acumulado += c[b];
+    }
+    if (b == _nBaldes) {
+        return _maior[serie];
+    }
+
+    // 3. Interpolação linear dentro do balde (amostras supostas uniformes nele),
+    //    limitada aos extremos exatos da série
+    double fracao = (alvo - static_cast<double>(acumulado)) / static_cast<double>(c[b]);
+    double valor = _minimo + (static_cast<double>(b) + fracao) / _escala;
+    return std::min(_maior[serie], std::max(_menor[serie], valor));
+}
@@ -0,0 +1,118 @@
+#ifndef HISTOGRAMAQUANTIS_H
+#define HISTOGRAMAQUANTIS_H
+
+#include <cstddef> // Para std::size_t
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class HistogramaQuantis
+ * @brief Estimador de quantis em fluxo contínuo por histogramas de baldes fixos.
+ *
+ * Guarda, para cada uma de várias séries (ex: um ponto de Sw da curva), a
+ * contagem de valores em baldes de mesma largura sobre [minimo, maximo].
+ * A memória não depende do número de amostras, e dois histogramas se
+ * juntam somando contagens inteiras: o resultado é exatamente o mesmo em
+ * qualquer ordem de junção, logo independente do número de threads (o que
+ * não vale para estimadores como o P² de Jain e Chlamtac).
+ *
+ * O quantil é interpolado linearmente dentro do balde, com erro máximo de
+ * uma largura de balde, (maximo - minimo) / nBaldes, e limitado ao menor e
+ * ao maior valor exatos da série (também independentes da ordem): uma série
+ * constante, como fw = 0 abaixo de Swir, tem quantis exatos. Valores fora
+ * da faixa não entram em nenhum balde: são contados à parte (foraDaFaixa),
+ * e um quantil que caia entre eles é NaN, em vez de ser truncado na ponta.
+ */
+class HistogramaQuantis {
+private:
+    /// Número de séries.
+    std::size_t _nSeries;
+
+    /// Número de baldes por série.
+    std::size_t _nBaldes;
+
+    /// Limite inferior da faixa.
+    double _minimo;
+
+    /// Limite superior da faixa.
+    double _maximo;
+
+    /// nBaldes / (maximo - minimo).
+    double _escala;
+
+    /// Contagens, série a série (nSeries x nBaldes, contíguas).
+    std::vector<std::uint32_t> _contagem;
+
+    /// Total de amostras de cada série (dentro e fora da faixa).
+    std::vector<std::uint64_t> _total;
+
+    /// Amostras de cada série abaixo do mínimo.
+    std::vector<std::uint64_t> _abaixo;
+
+    /// Amostras de cada série acima do máximo.
+    std::vector<std::uint64_t> _acima;
+
+    /// Menor e maior valor exato de cada série (limitam o quantil interpolado).
+    std::vector<double> _menor;
+    std::vector<double> _maior;
+
+public:
+    /**
+     * @brief Construtor.
+     * @param nSeries Número de séries independentes.
+     * @param nBaldes Número de baldes por série.
+     * @param minimo Limite inferior da faixa.
+     * @param maximo Limite superior da faixa.
+     */
+    HistogramaQuantis(std::size_t nSeries, std::size_t nBaldes, double minimo, double maximo);
+
+    /**
+     * @brief Conta um valor numa série.
+     * @param serie Índice da série.
+     * @param valor O valor amostrado.
+     */
+    void adicionar(std::size_t serie, double valor) {
+        ++_total[serie];
+        _menor[serie] = valor < _menor[serie] ? valor : _menor[serie];
+        _maior[serie] = valor > _maior[serie] ? valor : _maior[serie];
+
+        // Fora da faixa: contado à parte (o valor igual ao máximo fica no último balde)
+        if (valor < _minimo) {
+            ++_abaixo[serie];
+            return;
+        }
+        if (!(valor <= _maximo)) {
+            ++_acima[serie];
+            return;
+        }
+        double x = (valor - _minimo) * _escala;
+        std::size_t b = (x >= static_cast<double>(_nBaldes)) ? _nBaldes - 1 : static_cast<std::size_t>(x);
+        ++_contagem[serie * _nBaldes + b];
+    }
+
+    /**
+     * @brief Soma as contagens de outro histograma (mesma forma) a este.
+     * @param outro Histograma a juntar.
+     */
+    void juntar(const HistogramaQuantis& outro);
+
+    /**
+     * @brief Estima o quantil p de uma série.
+     * @param serie Índice da série.
+     * @param p Probabilidade em [0, 1] (ex: 0.1 para P10).
+     * @return O quantil; NaN se a série não tiver amostras ou se o quantil
+     * cair entre as amostras fora da faixa.
+     */
+    double quantil(std::size_t serie, double p) const;
+
+    /**
+     * @brief Número de amostras de uma série fora de [minimo, maximo].
+     * @param serie Índice da série.
+     */
+    std::uint64_t foraDaFaixa(std::size_t serie) const { return _abaixo[serie] + _acima[serie]; }
+
+    /// Número de séries.
+    std::size_t numeroSeries() const { return _nSeries; }
+};
+
+#endif
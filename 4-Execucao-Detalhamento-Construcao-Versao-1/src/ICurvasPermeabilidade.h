@@ -2,6 +2,8 @@
 #define ICURVASPERMEABILIDADE_H
 
 #include <string>
+#include <vector>
+#include <cstddef> // Para std::size_t
 
 /**
  * @class ICurvasPermeabilidade
@@ -23,6 +25,9 @@ public:
      *
      * Cada classe filha deve implementar este método para ler seus
      * parâmetros específicos do arquivo de entrada (ex: ler a tabela ou ler os parâmetros de Corey).
+     * É o único método que altera o modelo: não deve ser chamado enquanto
+     * outras threads o usam. Os métodos const podem ser chamados por várias
+     * threads ao mesmo tempo sobre o mesmo modelo.
      * @param arquivo O caminho (path) para o arquivo de configuração .txt.
      */
     virtual void carregarDados(const std::string& arquivo) = 0;
@@ -40,6 +45,74 @@ public:
      * @return O valor de Kro (entre 0 e 1).
      */
     virtual double getKro(double sw) const = 0;
+
+    /**
+     * @brief Saturações onde Kr não é suave (quebras de inclinação).
+     *
+     * Usado pela amostragem adaptativa da curva de fw, que inclui esses
+     * pontos exatamente. A implementação padrão não informa nenhum.
+     * @return As saturações de quebra (em qualquer ordem).
+     */
+    virtual std::vector<double> pontosDeQuebra() const {
+        return {};
+    }
+
+    /**
+     * @brief Calcula Krw e Kro de uma única saturação.
+     *
+     * Os modelos concretos (classes final) definem esta função em linha no
+     * cabeçalho, para que a CalculadoraFluxoFracionarioEspecializada a
+     * expanda sem passar pela tabela virtual.
+     * @param sw A saturação de água.
+     * @param krw Saída: o valor de Krw.
+     * @param kro Saída: o valor de Kro.
+     */
+    virtual void calcularKrPonto(double sw, double& krw, double& kro) const {
+        krw = getKrw(sw);
+        kro = getKro(sw);
+    }
+
+    /**
+     * @brief Calcula Krw e Kro para um lote de saturações em uma única chamada.
+     *
+     * Evita o custo de duas chamadas virtuais por ponto e permite que cada
+     * modelo compartilhe o trabalho comum (normalização, busca do intervalo)
+     * entre Krw e Kro. A implementação padrão apenas repete getKrw/getKro;
+     * os modelos concretos sobrescrevem com uma versão nativa.
+     * @param sw Vetor de entrada com as saturações de água (n valores).
+     * @param krw Vetor de saída para os valores de Krw (n valores, alocado pelo chamador).
+     * @param kro Vetor de saída para os valores de Kro (n valores, alocado pelo chamador).
+     * @param n Número de saturações do lote.
+     */
+    virtual void calcularKrLote(const double* sw, double* krw, double* kro, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            krw[i] = getKrw(sw[i]);
+            kro[i] = getKro(sw[i]);
+        }
+    }
+
+    /**
+     * @brief Calcula Krw, Kro e suas derivadas em relação a Sw para um lote.
+     *
+     * Os modelos concretos fornecem derivadas analíticas (fórmula fechada no
+     * Corey, inclinação do segmento no tabelado). A implementação padrão usa
+     * diferenças centradas e serve apenas para modelos que não a sobrescrevam.
+     * @param sw Vetor de entrada com as saturações de água (n valores).
+     * @param krw Vetor de saída para Krw.
+     * @param kro Vetor de saída para Kro.
+     * @param dkrw Vetor de saída para dKrw/dSw.
+     * @param dkro Vetor de saída para dKro/dSw.
+     * @param n Número de saturações do lote.
+     */
+    virtual void calcularKrDerivadaLote(const double* sw, double* krw, double* kro,
+                                        double* dkrw, double* dkro, std::size_t n) const {
+        const double h = 1e-7;
+        calcularKrLote(sw, krw, kro, n);
+        for (std::size_t i = 0; i < n; ++i) {
+            dkrw[i] = (getKrw(sw[i] + h) - getKrw(sw[i] - h)) / (2.0 * h);
+            dkro[i] = (getKro(sw[i] + h) - getKro(sw[i] - h)) / (2.0 * h);
+        }
+    }
 };
 
 #endif
@@ -0,0 +1,489 @@
+#include "KernelCoreySimd.h"
+#include <cmath>     // Para std::pow
+#include <algorithm> // Para std::max e std::min
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define FW_KERNEL_SSE2 1
+#include <immintrin.h>
+#endif
+
+#if defined(FW_KERNEL_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define FW_KERNEL_AVX2 1
+#define FW_ALVO_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace {
+
+// --- Constantes comuns às versões vetoriais ---
+
+// ln(2) dividido em parte alta (com zeros nos bits baixos, k*LN2_ALTO é exato
+// para |k| < 2048) e parte baixa.
+const double LN2_ALTO = 6.93147180369123816490e-01;
+const double LN2_BAIXO = 1.90821492927058770002e-10;
+const double INV_LN2 = 1.44269504088896338700e+00;
+const double RAIZ2 = 1.41421356237309514547e+00;
+
+// Número mágico 1.5*2^52: somado a |v| < 2^51 arredonda v para o inteiro mais próximo
+const double MAGICO = 6755399441055744.0;
+
+// Menor double normal; abaixo disso a saturação normalizada é tratada como zero
+const double MENOR_NORMAL = 2.2250738585072014e-308;
+
+// Abaixo deste expoente exp(t) já é zero em double
+const double EXP_MINIMO = -745.2;
+
+// Coeficientes 2/(2k+1) da série log(m) = 2*atanh(s) = s*(C0 + z*(C1 + ...)), z = s^2
+const double C_LOG[12] = {
+    2.0, 2.0 / 3.0, 2.0 / 5.0, 2.0 / 7.0, 2.0 / 9.0, 2.0 / 11.0,
+    2.0 / 13.0, 2.0 / 15.0, 2.0 / 17.0, 2.0 / 19.0, 2.0 / 21.0, 2.0 / 23.0
+};
+
+// Coeficientes 1/k! da série de Taylor de exp(r), k = 0..12 (|r| <= ln(2)/2)
+const double C_EXP[13] = {
+    1.0, 1.0, 1.0 / 2.0, 1.0 / 6.0, 1.0 / 24.0, 1.0 / 120.0, 1.0 / 720.0,
+    1.0 / 5040.0, 1.0 / 40320.0, 1.0 / 362880.0, 1.0 / 3628800.0,
+    1.0 / 39916800.0, 1.0 / 479001600.0
+};
+
+
+/**
+ * @brief x^n escalar: caminho especializado da forma ou std::pow.
+ */
+inline double potenciaEscalar(double x, double n, const ExpoenteCorey& forma) {
+    return forma.forma == ExpoenteCorey::Forma::Geral ? std::pow(x, n) : forma.aplicar(x);
+}
+
+/**
+ * @brief Versão escalar de referência (std::pow), usada como fallback.
+ */
+void calcularKrEscalar(const ParametrosKernelCorey& p, const double* sw, double* krw, double* kro, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        double s = (sw[i] - p.swir) * p.inversoDenominador;
+        s = std::max(0.0, std::min(1.0, s));
+
+        krw[i] = p.krw_max * potenciaEscalar(s, p.nw, p.formaNw);
+        kro[i] = p.kro_max * potenciaEscalar(1.0 - s, p.no, p.formaNo);
+    }
+}
+
+/**
+ * @brief Aplica um kernel vetorial de largura L a todo o lote.
+ * A cauda (n % L pontos) é copiada para um bloco completo, de modo que
+ * todos os pontos passam pela mesma aproximação.
+ */
+template <std::size_t L, typename Bloco>
+void percorrerLote(const double* sw, double* krw, double* kro, std::size_t n, Bloco bloco) {
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        bloco(sw + i, krw + i, kro + i);
+    }
+    if (i < n) {
+        double swCauda[L], krwCauda[L], kroCauda[L];
+        for (std::size_t j = 0; j < L; ++j) {
+            swCauda[j] = (i + j < n) ? sw[i + j] : sw[i];
+        }
+        bloco(swCauda, krwCauda, kroCauda);
+        for (std::size_t j = 0; i + j < n; ++j) {
+            krw[i + j] = krwCauda[j];
+            kro[i + j] = kroCauda[j];
+        }
+    }
+}
+
+#ifdef FW_KERNEL_SSE2
+
+// ====================== SSE2 (2 doubles por registro) ======================
+
+inline __m128d selecionar2(__m128d mascara, __m128d a, __m128d b) {
+    return _mm_or_pd(_mm_and_pd(mascara, a), _mm_andnot_pd(mascara, b));
+}
+
+// Os polinômios são avaliados pelo esquema de Estrin (pares de termos combinados
+// com x^2, x^4, x^8): a cadeia de dependências cai de 12 para 4 níveis, o que
+// importa mais aqui que o número de operações.
+
+/// Polinômio de grau 11 (12 coeficientes) pelo esquema de Estrin.
+inline __m128d estrin12_2d(__m128d x, const double* c) {
+    __m128d x2 = _mm_mul_pd(x, x);
+    __m128d x4 = _mm_mul_pd(x2, x2);
+    __m128d x8 = _mm_mul_pd(x4, x4);
+    __m128d q0 = _mm_add_pd(_mm_set1_pd(c[0]), _mm_mul_pd(_mm_set1_pd(c[1]), x));
+    __m128d q1 = _mm_add_pd(_mm_set1_pd(c[2]), _mm_mul_pd(_mm_set1_pd(c[3]), x));
+    __m128d q2 = _mm_add_pd(_mm_set1_pd(c[4]), _mm_mul_pd(_mm_set1_pd(c[5]), x));
+    __m128d q3 = _mm_add_pd(_mm_set1_pd(c[6]), _mm_mul_pd(_mm_set1_pd(c[7]), x));
+    __m128d q4 = _mm_add_pd(_mm_set1_pd(c[8]), _mm_mul_pd(_mm_set1_pd(c[9]), x));
+    __m128d q5 = _mm_add_pd(_mm_set1_pd(c[10]), _mm_mul_pd(_mm_set1_pd(c[11]), x));
+    __m128d r0 = _mm_add_pd(q0, _mm_mul_pd(q1, x2));
+    __m128d r1 = _mm_add_pd(q2, _mm_mul_pd(q3, x2));
+    __m128d r2 = _mm_add_pd(q4, _mm_mul_pd(q5, x2));
+    return _mm_add_pd(_mm_add_pd(r0, _mm_mul_pd(r1, x4)), _mm_mul_pd(r2, x8));
+}
+
+/// Polinômio de grau 12 (13 coeficientes) pelo esquema de Estrin.
+inline __m128d estrin13_2d(__m128d x, const double* c) {
+    __m128d x4 = _mm_mul_pd(_mm_mul_pd(x, x), _mm_mul_pd(x, x));
+    __m128d x8 = _mm_mul_pd(x4, x4);
+    return _mm_add_pd(estrin12_2d(x, c), _mm_mul_pd(_mm_mul_pd(_mm_set1_pd(c[12]), x4), x8));
+}
+
+/// log(x) para x normal e positivo.
+inline __m128d log2d(__m128d x) {
+    const __m128i bits = _mm_castpd_si128(x);
+
+    // Expoente: 2^52 + e_polarizado, convertido para double sem instrução int64->double
+    __m128i expoente = _mm_srli_epi64(bits, 52);
+    __m128d e = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(expoente, _mm_castpd_si128(_mm_set1_pd(4503599627370496.0)))),
+                           _mm_set1_pd(4503599627370496.0 + 1023.0));
+
+    // Mantissa em [1, 2), trazida para [sqrt(2)/2, sqrt(2))
+    __m128d m = _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                              _mm_set1_epi64x(0x3FF0000000000000LL)));
+    __m128d grande = _mm_cmpgt_pd(m, _mm_set1_pd(RAIZ2));
+    m = selecionar2(grande, _mm_mul_pd(m, _mm_set1_pd(0.5)), m);
+    e = _mm_add_pd(e, _mm_and_pd(grande, _mm_set1_pd(1.0)));
+
+    // log(m) = 2*atanh(s), s = (m - 1)/(m + 1)
+    __m128d s = _mm_div_pd(_mm_sub_pd(m, _mm_set1_pd(1.0)), _mm_add_pd(m, _mm_set1_pd(1.0)));
+    __m128d z = _mm_mul_pd(s, s);
+    __m128d poli = estrin12_2d(z, C_LOG);
+    __m128d logm = _mm_mul_pd(s, poli);
+
+    return _mm_add_pd(_mm_mul_pd(e, _mm_set1_pd(LN2_ALTO)),
+                      _mm_add_pd(logm, _mm_mul_pd(e, _mm_set1_pd(LN2_BAIXO))));
+}
+
+/// exp(t) para t <= 0.
+inline __m128d exp2d(__m128d t) {
+    __m128d abaixo = _mm_cmplt_pd(t, _mm_set1_pd(EXP_MINIMO));
+    t = _mm_max_pd(t, _mm_set1_pd(EXP_MINIMO));
+
+    // k = round(t / ln2), r = t - k*ln2
+    const __m128d magico = _mm_set1_pd(MAGICO);
+    __m128d k = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(t, _mm_set1_pd(INV_LN2)), magico), magico);
+    __m128d r = _mm_sub_pd(_mm_sub_pd(t, _mm_mul_pd(k, _mm_set1_pd(LN2_ALTO))), _mm_mul_pd(k, _mm_set1_pd(LN2_BAIXO)));
+
+    __m128d poli = estrin13_2d(r, C_EXP);
+
+    // 2^k = 2^k1 * 2^k2 (evita expoentes fora da faixa normal quando o resultado é subnormal)
+    __m128d k1 = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(k, _mm_set1_pd(0.5)), magico), magico);
+    __m128d k2 = _mm_sub_pd(k, k1);
+    __m128d bias = _mm_set1_pd(MAGICO + 1023.0);
+    __m128d p1 = _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(_mm_add_pd(k1, bias)), 52));
+    __m128d p2 = _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(_mm_add_pd(k2, bias)), 52));
+
+    __m128d resultado = _mm_mul_pd(_mm_mul_pd(poli, p1), p2);
+    return _mm_andnot_pd(abaixo, resultado);
+}
+
+/// x^y para x em [0, 1] e y >= 0 (valorZero = 0^y).
+inline __m128d pow2d(__m128d x, __m128d y, __m128d valorZero) {
+    __m128d normal = _mm_cmpge_pd(x, _mm_set1_pd(MENOR_NORMAL));
+    __m128d xs = selecionar2(normal, x, _mm_set1_pd(1.0));
+    __m128d resultado = exp2d(_mm_mul_pd(y, log2d(xs)));
+    return selecionar2(normal, resultado, valorZero);
+}
+
+/// x^k por exponenciação binária (k fixo para todo o lote).
+inline __m128d potenciaInteira2d(__m128d x, unsigned k) {
+    __m128d resultado = _mm_set1_pd(1.0);
+    while (k != 0) {
+        if (k & 1u) {
+            resultado = _mm_mul_pd(resultado, x);
+        }
+        x = _mm_mul_pd(x, x);
+        k >>= 1;
+    }
+    return resultado;
+}
+
+/// x^y com o caminho da forma do expoente (multiplicações, raiz ou exp/log).
+inline __m128d potencia2d(__m128d x, __m128d y, __m128d valorZero, const ExpoenteCorey& forma) {
+    switch (forma.forma) {
+        case ExpoenteCorey::Forma::Inteiro:
+            return potenciaInteira2d(x, forma.parteInteira);
+        case ExpoenteCorey::Forma::SemiInteiro:
+            return _mm_mul_pd(potenciaInteira2d(x, forma.parteInteira), _mm_sqrt_pd(x));
+        default:
+            return pow2d(x, y, valorZero);
+    }
+}
+
+void calcularKrSse2(const ParametrosKernelCorey& p, const double* sw, double* krw, double* kro, std::size_t n) {
+    const __m128d swir = _mm_set1_pd(p.swir);
+    const __m128d inv = _mm_set1_pd(p.inversoDenominador);
+    const __m128d krwMax = _mm_set1_pd(p.krw_max);
+    const __m128d kroMax = _mm_set1_pd(p.kro_max);
+    const __m128d nw = _mm_set1_pd(p.nw);
+    const __m128d no = _mm_set1_pd(p.no);
+    const __m128d zeroNw = _mm_set1_pd(p.nw == 0.0 ? 1.0 : 0.0);
+    const __m128d zeroNo = _mm_set1_pd(p.no == 0.0 ? 1.0 : 0.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d um = _mm_set1_pd(1.0);
+
+    percorrerLote<2>(sw, krw, kro, n, [&](const double* s_in, double* krw_out, double* kro_out) {
+        // Normalização e clamp em [0, 1]
+        __m128d s = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(s_in), swir), inv);
+        s = _mm_max_pd(zero, _mm_min_pd(um, s));
+
+        _mm_storeu_pd(krw_out, _mm_mul_pd(krwMax, potencia2d(s, nw, zeroNw, p.formaNw)));
+        _mm_storeu_pd(kro_out, _mm_mul_pd(kroMax, potencia2d(_mm_sub_pd(um, s), no, zeroNo, p.formaNo)));
+    });
+}
+
+#endif // FW_KERNEL_SSE2
+
+#ifdef FW_KERNEL_AVX2
+
+// =================== AVX2 + FMA (4 doubles por registro) ===================
+
+/// Polinômio de grau 11 (12 coeficientes) pelo esquema de Estrin.
+FW_ALVO_AVX2 inline __m256d estrin12_4d(__m256d x, const double* c) {
+    __m256d x2 = _mm256_mul_pd(x, x);
+    __m256d x4 = _mm256_mul_pd(x2, x2);
+    __m256d x8 = _mm256_mul_pd(x4, x4);
+    __m256d q0 = _mm256_fmadd_pd(_mm256_set1_pd(c[1]), x, _mm256_set1_pd(c[0]));
+    __m256d q1 = _mm256_fmadd_pd(_mm256_set1_pd(c[3]), x, _mm256_set1_pd(c[2]));
+    __m256d q2 = _mm256_fmadd_pd(_mm256_set1_pd(c[5]), x, _mm256_set1_pd(c[4]));
+    __m256d q3 = _mm256_fmadd_pd(_mm256_set1_pd(c[7]), x, _mm256_set1_pd(c[6]));
+    __m256d q4 = _mm256_fmadd_pd(_mm256_set1_pd(c[9]), x, _mm256_set1_pd(c[8]));
+    __m256d q5 = _mm256_fmadd_pd(_mm256_set1_pd(c[11]), x, _mm256_set1_pd(c[10]));
+    __m256d r0 = _mm256_fmadd_pd(q1, x2, q0);
+    __m256d r1 = _mm256_fmadd_pd(q3, x2, q2);
+    __m256d r2 = _mm256_fmadd_pd(q5, x2, q4);
+    return _mm256_fmadd_pd(r2, x8, _mm256_fmadd_pd(r1, x4, r0));
+}
+
+/// Polinômio de grau 12 (13 coeficientes) pelo esquema de Estrin.
+FW_ALVO_AVX2 inline __m256d estrin13_4d(__m256d x, const double* c) {
+    __m256d x2 = _mm256_mul_pd(x, x);
+    __m256d x4 = _mm256_mul_pd(x2, x2);
+    __m256d x8 = _mm256_mul_pd(x4, x4);
+    return _mm256_fmadd_pd(_mm256_mul_pd(_mm256_set1_pd(c[12]), x4), x8, estrin12_4d(x, c));
+}
+
+FW_ALVO_AVX2 inline __m256d log4d(__m256d x) {
+    const __m256i bits = _mm256_castpd_si256(x);
+
+    __m256i expoente = _mm256_srli_epi64(bits, 52);
+    __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(expoente, _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0)))),
+                              _mm256_set1_pd(4503599627370496.0 + 1023.0));
+
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                                    _mm256_set1_epi64x(0x3FF0000000000000LL)));
+    __m256d grande = _mm256_cmp_pd(m, _mm256_set1_pd(RAIZ2), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), grande);
+    e = _mm256_add_pd(e, _mm256_and_pd(grande, _mm256_set1_pd(1.0)));
+
+    __m256d s = _mm256_div_pd(_mm256_sub_pd(m, _mm256_set1_pd(1.0)), _mm256_add_pd(m, _mm256_set1_pd(1.0)));
+    __m256d z = _mm256_mul_pd(s, s);
+    __m256d poli = estrin12_4d(z, C_LOG);
+    __m256d logm = _mm256_mul_pd(s, poli);
+
+    return _mm256_fmadd_pd(e, _mm256_set1_pd(LN2_ALTO), _mm256_fmadd_pd(e, _mm256_set1_pd(LN2_BAIXO), logm));
+}
+
+FW_ALVO_AVX2 inline __m256d exp4d(__m256d t) {
+    __m256d abaixo = _mm256_cmp_pd(t, _mm256_set1_pd(EXP_MINIMO), _CMP_LT_OQ);
+    t = _mm256_max_pd(t, _mm256_set1_pd(EXP_MINIMO));
+
+    const __m256d magico = _mm256_set1_pd(MAGICO);
+    __m256d k = _mm256_sub_pd(_mm256_fmadd_pd(t, _mm256_set1_pd(INV_LN2), magico), magico);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_BAIXO), _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_ALTO), t));
+
+    __m256d poli = estrin13_4d(r, C_EXP);
+
+    __m256d k1 = _mm256_sub_pd(_mm256_fmadd_pd(k, _mm256_set1_pd(0.5), magico), magico);
+    __m256d k2 = _mm256_sub_pd(k, k1);
+    __m256d bias = _mm256_set1_pd(MAGICO + 1023.0);
+    __m256d p1 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(k1, bias)), 52));
+    __m256d p2 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(k2, bias)), 52));
+
+    __m256d resultado = _mm256_mul_pd(_mm256_mul_pd(poli, p1), p2);
+    return _mm256_andnot_pd(abaixo, resultado);
+}
+
+FW_ALVO_AVX2 inline __m256d pow4d(__m256d x, __m256d y, __m256d valorZero) {
+    __m256d normal = _mm256_cmp_pd(x, _mm256_set1_pd(MENOR_NORMAL), _CMP_GE_OQ);
+    __m256d xs = _mm256_blendv_pd(_mm256_set1_pd(1.0), x, normal);
+    __m256d resultado = exp4d(_mm256_mul_pd(y, log4d(xs)));
+    return _mm256_blendv_pd(valorZero, resultado, normal);
+}
+
+/// x^k por exponenciação binária (k fixo para todo o lote).
+FW_ALVO_AVX2 inline __m256d potenciaInteira4d(__m256d x, unsigned k) {
+    __m256d resultado = _mm256_set1_pd(1.0);
+    while (k != 0) {
+        if (k & 1u) {
+            resultado = _mm256_mul_pd(resultado, x);
+        }
+        x = _mm256_mul_pd(x, x);
+        k >>= 1;
+    }
+    return resultado;
+}
+
+/// x^y com o caminho da forma do expoente (multiplicações, raiz ou exp/log).
+FW_ALVO_AVX2 inline __m256d potencia4d(__m256d x, __m256d y, __m256d valorZero, const ExpoenteCorey& forma) {
+    switch (forma.forma) {
+        case ExpoenteCorey::Forma::Inteiro:
+            return potenciaInteira4d(x, forma.parteInteira);
+        case ExpoenteCorey::Forma::SemiInteiro:
+            return _mm256_mul_pd(potenciaInteira4d(x, forma.parteInteira), _mm256_sqrt_pd(x));
+        default:
+            return pow4d(x, y, valorZero);
+    }
+}
+
+/// Normalização, clamp em [0, 1] e as duas potências de 4 saturações.
+FW_ALVO_AVX2 inline void blocoKrAvx2(const ParametrosKernelCorey& p, __m256d sw, __m256d& krw, __m256d& kro) {
+    const __m256d um = _mm256_set1_pd(1.0);
+    __m256d s = _mm256_mul_pd(_mm256_sub_pd(sw, _mm256_set1_pd(p.swir)), _mm256_set1_pd(p.inversoDenominador));
+    s = _mm256_max_pd(_mm256_setzero_pd(), _mm256_min_pd(um, s));
+
+    krw = _mm256_mul_pd(_mm256_set1_pd(p.krw_max),
+                        potencia4d(s, _mm256_set1_pd(p.nw), _mm256_set1_pd(p.nw == 0.0 ? 1.0 : 0.0), p.formaNw));
+    kro = _mm256_mul_pd(_mm256_set1_pd(p.kro_max),
+                        potencia4d(_mm256_sub_pd(um, s), _mm256_set1_pd(p.no), _mm256_set1_pd(p.no == 0.0 ? 1.0 : 0.0),
+                                   p.formaNo));
+}
+
+FW_ALVO_AVX2 void calcularKrAvx2(const ParametrosKernelCorey& p, const double* sw, double* krw, double* kro, std::size_t n) {
+    // O laço fica explícito (sem lambda) para que todo o corpo herde o alvo AVX2
+    std::size_t i = 0;
+    double swCauda[4], krwCauda[4], kroCauda[4];
+    while (i < n) {
+        const double* s_in = sw + i;
+        double* krw_out = krw + i;
+        double* kro_out = kro + i;
+        std::size_t resto = n - i;
+        if (resto < 4) {
+            for (std::size_t j = 0; j < 4; ++j) {
+                swCauda[j] = (j < resto) ? sw[i + j] : sw[i];
+            }
+            s_in = swCauda;
+            krw_out = krwCauda;
+            kro_out = kroCauda;
+        }
+
+        __m256d krw4, kro4;
+        blocoKrAvx2(p, _mm256_loadu_pd(s_in), krw4, kro4);
+        _mm256_storeu_pd(krw_out, krw4);
+        _mm256_storeu_pd(kro_out, kro4);
+
+        if (resto < 4) {
+            for (std::size_t j = 0; j < resto; ++j) {
+                krw[i + j] = krwCauda[j];
+                kro[i + j] = kroCauda[j];
+            }
+        }
+        i += 4;
+    }
+}
+
+/// Um único ponto: a saturação é replicada nas 4 faixas e lida da primeira.
+FW_ALVO_AVX2 void calcularKrPontoAvx2(const ParametrosKernelCorey& p, double sw, double& krw, double& kro) {
+    __m256d krw4, kro4;
+    blocoKrAvx2(p, _mm256_set1_pd(sw), krw4, kro4);
+    krw = _mm256_cvtsd_f64(krw4);
+    kro = _mm256_cvtsd_f64(kro4);
+}
+
+#endif // FW_KERNEL_AVX2
+
+/**
+ * @brief Verifica se a CPU suporta AVX2 e FMA.
+ */
+bool cpuTemAvx2() {
+#if defined(FW_KERNEL_AVX2)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief Retorna a implementação detectada (calculada uma única vez).
+ */
+KernelCoreySimd::Implementacao KernelCoreySimd::implementacaoDetectada() {
+    // O SSE2 não é mais rápido que o std::pow escalar, então só o AVX2 é preferido
+    static const Implementacao detectada = cpuTemAvx2() ? Implementacao::Avx2 : Implementacao::Escalar;
+    return detectada;
+}
+
+/**
+ * @brief Indica se a CPU atual suporta uma implementação.
+ */
+bool KernelCoreySimd::suportada(Implementacao impl) {
+    switch (impl) {
+        case Implementacao::Avx2: {
+            static const bool temAvx2 = cpuTemAvx2();
+            return temAvx2;
+        }
+#ifdef FW_KERNEL_SSE2
+        case Implementacao::Sse2: return true;
+#endif
+        case Implementacao::Escalar: return true;
+        default: return false;
+    }
+}
+
+/**
+ * @brief Nome legível de uma implementação.
+ */
+const char* KernelCoreySimd::nome(Implementacao impl) {
+    switch (impl) {
+        case Implementacao::Avx2: return "AVX2+FMA";
+        case Implementacao::Sse2: return "SSE2";
+        default:                  return "Escalar";
+    }
+}
+
+/**
+ * @brief Calcula Krw e Kro de Corey em lote com a implementação detectada.
+ */
+void KernelCoreySimd::calcularKr(const ParametrosKernelCorey& p, const double* sw, double* krw, double* kro, std::size_t n) {
+    calcularKr(p, sw, krw, kro, n, implementacaoDetectada());
+}
+
+/**
+ * @brief Calcula Krw e Kro de Corey de um ponto com a implementação detectada.
+ */
+void KernelCoreySimd::calcularKrPonto(const ParametrosKernelCorey& p, double sw, double& krw, double& kro) {
+#ifdef FW_KERNEL_AVX2
+    if (implementacaoDetectada() == Implementacao::Avx2) {
+        calcularKrPontoAvx2(p, sw, krw, kro);
+        return;
+    }
+#endif
+    calcularKrEscalar(p, &sw, &krw, &kro, 1);
+}
+
+/**
+ * @brief Calcula Krw e Kro de Corey em lote com uma implementação específica.
+ */
+void KernelCoreySimd::calcularKr(const ParametrosKernelCorey& p, const double* sw, double* krw, double* kro, std::size_t n,
+                                 Implementacao impl) {
+    // Uma implementação não suportada pela CPU recai na escalar
+    if (!suportada(impl)) {
+        impl = Implementacao::Escalar;
+    }
+
+    switch (impl) {
+#ifdef FW_KERNEL_AVX2
+        case Implementacao::Avx2:
+            calcularKrAvx2(p, sw, krw, kro, n);
+            return;
+#endif
+#ifdef FW_KERNEL_SSE2
+        case Implementacao::Sse2:
+            calcularKrSse2(p, sw, krw, kro, n);
+            return;
+#endif
+        default:
+            calcularKrEscalar(p, sw, krw, kro, n);
+            return;
+    }
+}
@@ -0,0 +1,64 @@
+#include "ModeloFluxoFracionario.h"
+#include "ConfiguracaoCaso.h"
+#include <stdexcept> // Para std::runtime_error
+#include <utility>   // Para std::move
+
+/**
+ * @brief Constrói a partir de um modelo de Kr já criado.
+ * @param mu_o Viscosidade do Óleo.
+ * @param mu_w Viscosidade da Água.
+ * @param modeloKr O modelo de Kr compartilhado.
+ */
+ModeloFluxoFracionario::ModeloFluxoFracionario(double mu_o, double mu_w,
+                                               std::shared_ptr<const ICurvasPermeabilidade> modeloKr)
+: _modeloKr(std::move(modeloKr)), _mu_o(mu_o), _mu_w(mu_w), _calculadora(mu_o, mu_w, _modeloKr.get()) {
+    // A calculadora já rejeita modelo nulo e viscosidades inválidas
+}
+
+/**
+ * @brief Cria um modelo com Kr de Corey.
+ */
+ModeloFluxoFracionario ModeloFluxoFracionario::corey(double mu_o, double mu_w, const ParametrosCorey& parametros) {
+    return ModeloFluxoFracionario(mu_o, mu_w, std::make_shared<const CurvasPermeabilidadeCorey>(parametros));
+}
+
+/**
+ * @brief Cria um modelo com Kr tabelado.
+ */
+ModeloFluxoFracionario ModeloFluxoFracionario::tabelado(double mu_o, double mu_w, const TabelaKr& tabela) {
+    return ModeloFluxoFracionario(mu_o, mu_w, std::make_shared<const CurvasPermeabilidadeTabelada>(tabela));
+}
+
+/**
+ * @brief Cria o modelo descrito por uma configuração.
+ * @param cfg A configuração já lida.
+ */
+ModeloFluxoFracionario ModeloFluxoFracionario::daConfiguracao(const ConfiguracaoCaso& cfg) {
+    if (cfg.mu_o() <= 0 || cfg.mu_w() <= 0) {
+        throw std::runtime_error("Erro: Viscosidades do oleo ou da agua nao definidas no arquivo.");
+    }
+    if (cfg.tipoModelo() == "TABELADO") {
+        return tabelado(cfg.mu_o(), cfg.mu_w(), cfg.tabela());
+    }
+    if (cfg.tipoModelo() == "COREY") {
+        return corey(cfg.mu_o(), cfg.mu_w(), cfg.corey());
+    }
+    throw std::runtime_error("Erro: MODELO_KR nao reconhecido. Use TABELADO ou COREY.");
+}
+
+/**
+ * @brief Lê um arquivo de entrada e cria o modelo que ele descreve.
+ * @param arquivo O caminho para o arquivo de configuração.
+ */
+ModeloFluxoFracionario ModeloFluxoFracionario::lerArquivo(const std::string& arquivo) {
+    return daConfiguracao(ConfiguracaoCaso::lerArquivo(arquivo));
+}
+
+/**
+ * @brief Outro par de viscosidades sobre o mesmo modelo de Kr.
+ * @param mu_o Viscosidade do Óleo.
+ * @param mu_w Viscosidade da Água.
+ */
+ModeloFluxoFracionario ModeloFluxoFracionario::comViscosidades(double mu_o, double mu_w) const {
+    return ModeloFluxoFracionario(mu_o, mu_w, _modeloKr);
+}
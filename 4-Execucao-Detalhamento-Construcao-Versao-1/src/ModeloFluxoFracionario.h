@@ -0,0 +1,141 @@
+#ifndef MODELOFLUXOFRACIONARIO_H
+#define MODELOFLUXOFRACIONARIO_H
+
+#include "ICurvasPermeabilidade.h"
+#include "CurvasPermeabilidadeCorey.h"
+#include "CurvasPermeabilidadeTabelada.h"
+#include "CalculadoraFluxoFracionario.h"
+#include <cstddef> // Para std::size_t
+#include <memory>  // Para std::shared_ptr
+#include <string>
+
+class ConfiguracaoCaso;
+
+/**
+ * @class ModeloFluxoFracionario
+ * @brief Ponto de entrada para embutir o cálculo de fw em outro simulador.
+ *
+ * Junta um modelo de Kr e a calculadora especializada para um par de
+ * viscosidades. O modelo de Kr é guardado como std::shared_ptr<const ...>:
+ * depois de construído ninguém o altera, e as cópias do ModeloFluxoFracionario
+ * (ou as criadas por comViscosidades) apenas o compartilham.
+ *
+ * Uso concorrente: todos os métodos são const, não usam estado global e
+ * não escrevem no console. Várias threads podem chamar fw/fwLote sobre a
+ * mesma instância ao mesmo tempo, sem trava e sem copiar o modelo; cada
+ * thread só precisa dos seus próprios vetores de saída.
+ *
+ * Biblioteca: o motor não depende do Simulador, do Gnuplot nem da saída em
+ * arquivo. Para gerar uma biblioteca estática, a partir do diretório src:
+ *
+ *     g++ -std=c++17 -O2 -pthread -I. -c ModeloFluxoFracionario.cpp CalculadoraFluxoFracionario.cpp \
+ *         CurvasPermeabilidadeCorey.cpp CurvasPermeabilidadeTabelada.cpp KernelCoreySimd.cpp \
+ *         ConfiguracaoCaso.cpp CacheFluxoFracionario.cpp TabelasKrRegioes.cpp PoolDeThreads.cpp
+ *     ar rcs libfluxofracionario.a *.o
+ *
+ * e ligar o simulador hospedeiro com -I<src> -L<src> -lfluxofracionario.
+ * Para malhas com vários tipos de rocha, ver TabelasKrRegioes.
+ */
+class ModeloFluxoFracionario {
+private:
+    /// Modelo de Kr imutável, compartilhado entre as cópias
+    std::shared_ptr<const ICurvasPermeabilidade> _modeloKr;
+
+    /// Viscosidade do Óleo (cPoise)
+    double _mu_o;
+
+    /// Viscosidade da Água (cPoise)
+    double _mu_w;
+
+    /// Calculadora especializada; aponta para *_modeloKr
+    CalculadoraFluxoFracionario _calculadora;
+
+public:
+    /**
+     * @brief Constrói a partir de um modelo de Kr já criado.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param modeloKr O modelo de Kr (não nulo); não deve mais ser alterado.
+     */
+    ModeloFluxoFracionario(double mu_o, double mu_w, std::shared_ptr<const ICurvasPermeabilidade> modeloKr);
+
+    /**
+     * @brief Cria um modelo com Kr de Corey.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param parametros Os 6 parâmetros de Corey.
+     * @return O modelo pronto para uso.
+     */
+    static ModeloFluxoFracionario corey(double mu_o, double mu_w, const ParametrosCorey& parametros);
+
+    /**
+     * @brief Cria um modelo com Kr tabelado.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param tabela A tabela de Kr (e o modo de interpolação).
+     * @return O modelo pronto para uso.
+     */
+    static ModeloFluxoFracionario tabelado(double mu_o, double mu_w, const TabelaKr& tabela);
+
+    /**
+     * @brief Cria o modelo descrito por uma configuração (VISC_OLEO, VISC_AGUA, MODELO_KR...).
+     * @param cfg A configuração já lida.
+     * @return O modelo pronto para uso.
+     */
+    static ModeloFluxoFracionario daConfiguracao(const ConfiguracaoCaso& cfg);
+
+    /**
+     * @brief Lê um arquivo de entrada e cria o modelo que ele descreve.
+     * @param arquivo O caminho para o arquivo de configuração.
+     * @return O modelo pronto para uso.
+     */
+    static ModeloFluxoFracionario lerArquivo(const std::string& arquivo);
+
+    /**
+     * @brief Outro par de viscosidades sobre o mesmo modelo de Kr (sem copiá-lo).
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @return O novo modelo, que compartilha o Kr com este.
+     */
+    ModeloFluxoFracionario comViscosidades(double mu_o, double mu_w) const;
+
+    /**
+     * @brief fw de uma saturação.
+     * @param sw A saturação de água.
+     * @return O valor de fw.
+     */
+    double fw(double sw) const { return _calculadora.calcularFw(sw); }
+
+    /**
+     * @brief fw de um lote de saturações (ex: todas as células de um passo de tempo).
+     * @param sw Vetor de saturações (n valores).
+     * @param fw Vetor de saída (n valores, alocado pelo chamador).
+     * @param n Número de pontos.
+     */
+    void fwLote(const double* sw, double* fw, std::size_t n) const { _calculadora.calcularFwLote(sw, fw, n); }
+
+    /**
+     * @brief fw e dfw/dSw de um lote de saturações.
+     * @param sw Vetor de saturações (n valores).
+     * @param fw Vetor de saída para fw.
+     * @param dfw Vetor de saída para dfw/dSw.
+     * @param n Número de pontos.
+     */
+    void fwDerivadaLote(const double* sw, double* fw, double* dfw, std::size_t n) const {
+        _calculadora.calcularFwDerivadaLote(sw, fw, dfw, n);
+    }
+
+    /// Calculadora completa (curvas, despachar), para quem precisa de mais que fw.
+    const CalculadoraFluxoFracionario& calculadora() const { return _calculadora; }
+
+    /// O modelo de Kr compartilhado.
+    const ICurvasPermeabilidade& modeloKr() const { return *_modeloKr; }
+
+    /// Viscosidade do Óleo (cPoise).
+    double mu_o() const { return _mu_o; }
+
+    /// Viscosidade da Água (cPoise).
+    double mu_w() const { return _mu_w; }
+};
+
+#endif
@@ -0,0 +1,254 @@
+#include "MonteCarloFluxoFracionario.h"
+#include "CalculadoraFluxoFracionario.h"
+#include "SolucionadorWelge.h"
+#include "PrevisaoProducao.h"
+#include "HistogramaQuantis.h"
+#include "EscritorColunas.h"
+#include <cmath>     // Para std::sqrt, std::log, std::exp, std::cos
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+/// Realizações por tarefa do pool (cada bloco tem seus próprios histogramas).
+const std::size_t REALIZACOES_POR_TAREFA = 512;
+
+/// Pontos da malha de PVI das curvas de recuperação.
+const std::size_t PONTOS_PVI = 61;
+
+/// Probabilidades dos quantis P10, P50 e P90.
+const double PROBABILIDADES[3] = {0.1, 0.5, 0.9};
+
+/**
+ * @brief Atribui um valor sorteado ao parâmetro correspondente.
+ */
+void atribuir(const std::string& parametro, double valor, double& mu_o, double& mu_w, ParametrosCorey& corey) {
+    if (parametro == "VISC_OLEO")          mu_o = valor;
+    else if (parametro == "VISC_AGUA")     mu_w = valor;
+    else if (parametro == "COREY_SWIR")    corey.swir = valor;
+    else if (parametro == "COREY_SORW")    corey.sorw = valor;
+    else if (parametro == "COREY_KRW_MAX") corey.krw_max = valor;
+    else if (parametro == "COREY_KRO_MAX") corey.kro_max = valor;
+    else if (parametro == "COREY_NW")      corey.nw = valor;
+    else if (parametro == "COREY_NO")      corey.no = valor;
+}
+
+/**
+ * @struct AcumuladorMonteCarlo
+ * @brief Histogramas de um bloco de realizações (ou do total).
+ */
+struct AcumuladorMonteCarlo {
+    HistogramaQuantis fw;               ///< fw em cada Sw da malha
+    HistogramaQuantis recuperacao;      ///< FR em cada PVI da malha
+    HistogramaQuantis frente;           ///< séries 0: Swf, 1: FR na ruptura
+    HistogramaQuantis pviRuptura;       ///< PVI na ruptura
+    std::size_t rejeitadas = 0;
+
+    AcumuladorMonteCarlo(std::size_t nSw, std::size_t baldes, double pviMaximo)
+    : fw(nSw, baldes, 0.0, 1.0), recuperacao(PONTOS_PVI, baldes, 0.0, 1.0),
+      frente(2, baldes, 0.0, 1.0), pviRuptura(1, baldes, 0.0, pviMaximo) {}
+
+    void juntar(const AcumuladorMonteCarlo& outro) {
+        fw.juntar(outro.fw);
+        recuperacao.juntar(outro.recuperacao);
+        frente.juntar(outro.frente);
+        pviRuptura.juntar(outro.pviRuptura);
+        rejeitadas += outro.rejeitadas;
+    }
+};
+
+/**
+ * @brief Extrai P10/P50/P90 de todas as séries de um histograma.
+ */
+EnvelopeQuantis envelope(const HistogramaQuantis& h) {
+    EnvelopeQuantis e;
+    for (std::size_t s = 0; s < h.numeroSeries(); ++s) {
+        e.p10.push_back(h.quantil(s, PROBABILIDADES[0]));
+        e.p50.push_back(h.quantil(s, PROBABILIDADES[1]));
+        e.p90.push_back(h.quantil(s, PROBABILIDADES[2]));
+    }
+    return e;
+}
+
+/**
+ * @brief P10/P50/P90 de uma série de um histograma.
+ */
+std::array<double, 3> quantis(const HistogramaQuantis& h, std::size_t serie) {
+    return {h.quantil(serie, PROBABILIDADES[0]), h.quantil(serie, PROBABILIDADES[1]), h.quantil(serie, PROBABILIDADES[2])};
+}
+
+} // namespace
+
+/**
+ * @brief Construtor: valida as distribuições contra o modelo base.
+ */
+MonteCarloFluxoFracionario::MonteCarloFluxoFracionario(const ICurvasPermeabilidade* modeloBase, double mu_o, double mu_w,
+                                                       double passo, const ParametrosMonteCarlo& parametros)
+: _modeloBase(modeloBase), _coreyBase{0, 0, 0, 0, 0, 0}, _variaCorey(false),
+  _mu_o(mu_o), _mu_w(mu_w), _passo(passo), _parametros(parametros), _gerador(parametros.semente) {
+
+    if (modeloBase == nullptr) {
+        throw std::runtime_error("Erro: Monte Carlo recebeu um modelo de permeabilidade nulo.");
+    }
+    if (_parametros.pviMaximo <= 0.0 || _parametros.baldes == 0) {
+        throw std::runtime_error("Erro: MC_PVI_MAX e MC_BALDES devem ser positivos.");
+    }
+
+    const CurvasPermeabilidadeCorey* corey = dynamic_cast<const CurvasPermeabilidadeCorey*>(modeloBase);
+    if (corey != nullptr) {
+        _coreyBase = corey->getParametros();
+    }
+    for (const DistribuicaoParametro& d : _parametros.distribuicoes) {
+        if (d.parametro.compare(0, 6, "COREY_") == 0) {
+            if (corey == nullptr) {
+                throw std::runtime_error("Erro: MC_DISTRIBUICAO " + d.parametro + " exige MODELO_KR COREY.");
+            }
+            _variaCorey = true;
+        }
+    }
+}
+
+/**
+ * @brief Sorteia um valor pela inversa da distribuição (Box-Muller nas normais).
+ * @param d A distribuição.
+ * @param u1 Primeiro uniforme.
+ * @param u2 Segundo uniforme.
+ * @return O valor sorteado.
+ */
+double MonteCarloFluxoFracionario::amostrar(const DistribuicaoParametro& d, double u1, double u2) {
+    const double doisPi = 6.283185307179586;
+    switch (d.tipo) {
+        case DistribuicaoParametro::Tipo::Uniforme:
+            return d.a + (d.b - d.a) * u1;
+
+        case DistribuicaoParametro::Tipo::Triangular: {
+            // a = mínimo, b = moda, c = máximo
+            double largura = d.c - d.a;
+            double fModa = (d.b - d.a) / largura;
+            return (u1 < fModa) ? d.a + std::sqrt(u1 * largura * (d.b - d.a))
+                                : d.c - std::sqrt((1.0 - u1) * largura * (d.c - d.b));
+        }
+
+        case DistribuicaoParametro::Tipo::Normal:
+            return d.a + d.b * std::sqrt(-2.0 * std::log(u1)) * std::cos(doisPi * u2);
+
+        case DistribuicaoParametro::Tipo::LogNormal:
+            return std::exp(d.a + d.b * std::sqrt(-2.0 * std::log(u1)) * std::cos(doisPi * u2));
+    }
+    return d.a;
+}
+
+/**
+ * @brief Executa as realizações em blocos no pool e junta os histogramas.
+ * @param pool Pool de threads.
+ * @return Os envelopes P10/P50/P90.
+ */
+ResultadoMonteCarlo MonteCarloFluxoFracionario::executar(PoolDeThreads& pool) const {
+    // 1. Malhas comuns a todas as realizações
+    const CurvaFluxoFracionario malha = CalculadoraFluxoFracionario(_mu_o, _mu_w, _modeloBase).gerarCurvaComDerivada(_passo);
+    const std::size_t nSw = malha.tamanho();
+
+    ResultadoMonteCarlo resultado;
+    resultado.sw = malha.sw();
+    resultado.pvi.resize(PONTOS_PVI);
+    for (std::size_t j = 0; j < PONTOS_PVI; ++j) {
+        resultado.pvi[j] = _parametros.pviMaximo * static_cast<double>(j) / static_cast<double>(PONTOS_PVI - 1);
+    }
+
+    AcumuladorMonteCarlo total(nSw, _parametros.baldes, _parametros.pviMaximo);
+    std::mutex mutexTotal;
+
+    // 2. Blocos de realizações; cada um com área de trabalho e histogramas próprios
+    pool.paraCadaBloco(_parametros.realizacoes, REALIZACOES_POR_TAREFA, [&](std::size_t inicio, std::size_t fim) {
+        AcumuladorMonteCarlo local(nSw, _parametros.baldes, _parametros.pviMaximo);
+        CurvaFluxoFracionario curva = malha; // Sw fixo; fw e dfw reescritos a cada realização
+        SolucionadorWelge welge;
+
+        for (std::size_t i = inicio; i < fim; ++i) {
+            // 2a. Sorteio: fluxo k do contador = k-ésima distribuição
+            double mu_o = _mu_o;
+            double mu_w = _mu_w;
+            ParametrosCorey corey = _coreyBase;
+            for (std::size_t k = 0; k < _parametros.distribuicoes.size(); ++k) {
+                double u1, u2;
+                _gerador.uniformes(i, static_cast<std::uint32_t>(k), u1, u2);
+                atribuir(_parametros.distribuicoes[k].parametro, amostrar(_parametros.distribuicoes[k], u1, u2),
+                         mu_o, mu_w, corey);
+            }
+
+            // 2b. Curva, frente e produção (realizações inválidas são descartadas)
+            try {
+                if (mu_o <= 0 || mu_w <= 0) {
+                    throw std::runtime_error("Erro: Viscosidade sorteada nao positiva.");
+                }
+                if (_variaCorey) {
+                    CurvasPermeabilidadeCorey modelo(corey);
+                    CalculadoraFluxoFracionario calc(mu_o, mu_w, &modelo);
+                    calc.calcularFwDerivadaLote(curva.sw().data(), curva.fw().data(), curva.dfw().data(), nSw);
+                } else {
+                    CalculadoraFluxoFracionario calc(mu_o, mu_w, _modeloBase);
+                    calc.calcularFwDerivadaLote(curva.sw().data(), curva.fw().data(), curva.dfw().data(), nSw);
+                }
+                ResultadoWelge frente = welge.resolver(curva);
+                SerieProducao serie = PrevisaoProducao::gerar(curva, frente);
+
+                // 2c. Contagem: fw ponto a ponto
+                for (std::size_t s = 0; s < nSw; ++s) {
+                    local.fw.adicionar(s, curva.fw()[s]);
+                }
+
+                // 2d. FR na malha de PVI (interpolação linear na série; constante após o fim dela)
+                std::size_t k = 0;
+                for (std::size_t j = 0; j < PONTOS_PVI; ++j) {
+                    double q = resultado.pvi[j];
+                    while (k + 1 < serie.pvi.size() && serie.pvi[k + 1] <= q) {
+                        ++k;
+                    }
+                    double fr = serie.fatorRecuperacao[k];
+                    if (k + 1 < serie.pvi.size() && serie.pvi[k + 1] > serie.pvi[k]) {
+                        double t = (q - serie.pvi[k]) / (serie.pvi[k + 1] - serie.pvi[k]);
+                        fr += t * (serie.fatorRecuperacao[k + 1] - serie.fatorRecuperacao[k]);
+                    }
+                    local.recuperacao.adicionar(j, fr);
+                }
+
+                // 2e. Grandezas da ruptura
+                local.frente.adicionar(0, frente.swFrente);
+                local.frente.adicionar(1, (frente.swMediaRuptura - frente.swInicial) / (1.0 - frente.swInicial));
+                local.pviRuptura.adicionar(0, frente.pviRuptura);
+            } catch (const std::exception&) {
+                ++local.rejeitadas;
+            }
+        }
+
+        // 3. Junção (soma de inteiros: independe da ordem dos blocos)
+        std::lock_guard<std::mutex> trava(mutexTotal);
+        total.juntar(local);
+    });
+
+    // 4. Quantis
+    resultado.rejeitadas = total.rejeitadas;
+    resultado.aceitas = _parametros.realizacoes - total.rejeitadas;
+    resultado.fw = envelope(total.fw);
+    resultado.fatorRecuperacao = envelope(total.recuperacao);
+    resultado.swFrente = quantis(total.frente, 0);
+    resultado.fatorRecuperacaoRuptura = quantis(total.frente, 1);
+    resultado.pviRuptura = quantis(total.pviRuptura, 0);
+    resultado.pviRupturaForaDaFaixa = static_cast<std::size_t>(total.pviRuptura.foraDaFaixa(0));
+    return resultado;
+}
+
+/**
+ * @brief Salva os envelopes de fw e do fator de recuperação.
+ * @param resultado Resultado do Monte Carlo.
+ * @param arquivoFw Arquivo do envelope de fw(Sw).
+ * @param arquivoRecuperacao Arquivo do envelope do fator de recuperação.
+ */
+void MonteCarloFluxoFracionario::salvar(const ResultadoMonteCarlo& resultado, const std::string& arquivoFw,
+                                        const std::string& arquivoRecuperacao) {
+    EscritorColunas::salvarCsv(arquivoFw, {{"Sw", &resultado.sw}, {"Fw P10", &resultado.fw.p10},
+                                           {"Fw P50", &resultado.fw.p50}, {"Fw P90", &resultado.fw.p90}});
+    EscritorColunas::salvarCsv(arquivoRecuperacao, {{"PVI", &resultado.pvi}, {"FR P10", &resultado.fatorRecuperacao.p10},
+                                                    {"FR P50", &resultado.fatorRecuperacao.p50},
+                                                    {"FR P90", &resultado.fatorRecuperacao.p90}});
+}
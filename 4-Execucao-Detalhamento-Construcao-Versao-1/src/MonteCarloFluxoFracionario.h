@@ -0,0 +1,139 @@
+#ifndef MONTECARLOFLUXOFRACIONARIO_H
+#define MONTECARLOFLUXOFRACIONARIO_H
+
+#include "ICurvasPermeabilidade.h"
+#include "CurvasPermeabilidadeCorey.h"
+#include "ConfiguracaoCaso.h"
+#include "GeradorPhilox.h"
+#include "PoolDeThreads.h"
+#include <array>
+#include <string>
+#include <vector>
+#include <cstddef> // Para std::size_t
+
+/**
+ * @struct EnvelopeQuantis
+ * @brief Curvas P10, P50 e P90 (quantis de 10%, 50% e 90%) ponto a ponto.
+ */
+struct EnvelopeQuantis {
+    std::vector<double> p10;
+    std::vector<double> p50;
+    std::vector<double> p90;
+};
+
+/**
+ * @struct ResultadoMonteCarlo
+ * @brief Envelopes probabilísticos de fw(Sw) e do fator de recuperação.
+ */
+struct ResultadoMonteCarlo {
+    /// Realizações calculadas.
+    std::size_t aceitas = 0;
+
+    /// Realizações descartadas (parâmetros fisicamente inválidos ou falha no cálculo).
+    std::size_t rejeitadas = 0;
+
+    /// Malha de Sw (a mesma de todas as realizações).
+    std::vector<double> sw;
+
+    /// Envelope de fw em cada Sw da malha.
+    EnvelopeQuantis fw;
+
+    /// Malha de volumes porosos injetados.
+    std::vector<double> pvi;
+
+    /// Envelope do fator de recuperação em cada PVI da malha.
+    EnvelopeQuantis fatorRecuperacao;
+
+    /// P10, P50 e P90 da saturação da frente (Swf).
+    std::array<double, 3> swFrente{};
+
+    /// P10, P50 e P90 do volume poroso injetado na ruptura (NaN se acima de MC_PVI_MAX).
+    std::array<double, 3> pviRuptura{};
+
+    /// Realizações com PVI na ruptura acima de MC_PVI_MAX (fora do histograma).
+    std::size_t pviRupturaForaDaFaixa = 0;
+
+    /// P10, P50 e P90 do fator de recuperação na ruptura.
+    std::array<double, 3> fatorRecuperacaoRuptura{};
+};
+
+/**
+ * @class MonteCarloFluxoFracionario
+ * @brief Análise de incerteza por Monte Carlo sobre viscosidades e parâmetros de Corey.
+ *
+ * Cada realização sorteia os parâmetros incertos (linhas MC_DISTRIBUICAO),
+ * calcula fw(Sw) e dfw/dSw, a frente de Welge e a previsão de produção, e
+ * conta os resultados em histogramas de baldes fixos (HistogramaQuantis):
+ * nenhuma realização é guardada. As realizações são divididas em blocos
+ * executados no PoolDeThreads; cada bloco tem seus histogramas, somados
+ * ao total no fim do bloco.
+ *
+ * O sorteio usa o GeradorPhilox com contador (realização, parâmetro), e a
+ * junção dos histogramas é uma soma de inteiros: o resultado é idêntico
+ * bit a bit para qualquer número de threads.
+ */
+class MonteCarloFluxoFracionario {
+private:
+    /// Modelo de Kr do arquivo (compartilhado quando só as viscosidades variam).
+    const ICurvasPermeabilidade* _modeloBase;
+
+    /// Parâmetros de Corey do arquivo (valores não sorteados).
+    ParametrosCorey _coreyBase;
+
+    /// Indica se algum parâmetro de Corey é sorteado (exige um modelo por realização).
+    bool _variaCorey;
+
+    /// Viscosidade do óleo base (cPoise).
+    double _mu_o;
+
+    /// Viscosidade da água base (cPoise).
+    double _mu_w;
+
+    /// Passo de saturação das curvas.
+    double _passo;
+
+    /// Configuração do Monte Carlo.
+    ParametrosMonteCarlo _parametros;
+
+    /// Gerador baseado em contador.
+    GeradorPhilox _gerador;
+
+    /**
+     * @brief Sorteia um valor de uma distribuição a partir de dois uniformes.
+     * @param d A distribuição.
+     * @param u1 Primeiro uniforme em (0, 1).
+     * @param u2 Segundo uniforme em (0, 1) (usado pelas normais).
+     * @return O valor sorteado.
+     */
+    static double amostrar(const DistribuicaoParametro& d, double u1, double u2);
+
+public:
+    /**
+     * @brief Construtor.
+     * @param modeloBase Modelo de Kr já construído a partir do arquivo.
+     * @param mu_o Viscosidade do óleo base (cPoise).
+     * @param mu_w Viscosidade da água base (cPoise).
+     * @param passo Passo de saturação das curvas.
+     * @param parametros Realizações, semente e distribuições.
+     */
+    MonteCarloFluxoFracionario(const ICurvasPermeabilidade* modeloBase, double mu_o, double mu_w, double passo,
+                               const ParametrosMonteCarlo& parametros);
+
+    /**
+     * @brief Executa todas as realizações no pool.
+     * @param pool Pool onde os blocos de realizações serão executados.
+     * @return Os envelopes P10/P50/P90.
+     */
+    ResultadoMonteCarlo executar(PoolDeThreads& pool) const;
+
+    /**
+     * @brief Salva os envelopes em dois arquivos .csv.
+     * @param resultado Resultado de executar.
+     * @param arquivoFw Arquivo do envelope de fw(Sw).
+     * @param arquivoRecuperacao Arquivo do envelope do fator de recuperação.
+     */
+    static void salvar(const ResultadoMonteCarlo& resultado, const std::string& arquivoFw,
+                       const std::string& arquivoRecuperacao);
+};
+
+#endif
@@ -0,0 +1,194 @@
+#include "PoolDeThreads.h"
+#include <algorithm> // Para std::min
+
+/**
+ * @brief Cria o pool e inicia as threads.
+ * @param numeroThreads Número de threads (0 = número de núcleos).
+ */
+PoolDeThreads::PoolDeThreads(std::size_t numeroThreads) {
+    if (numeroThreads == 0) {
+        numeroThreads = std::thread::hardware_concurrency();
+        if (numeroThreads == 0) {
+            numeroThreads = 1;
+        }
+    }
+
+    for (std::size_t i = 0; i < numeroThreads; ++i) {
+        _filas.push_back(std::unique_ptr<Fila>(new Fila()));
+    }
+    for (std::size_t i = 0; i < numeroThreads; ++i) {
+        _threads.emplace_back(&PoolDeThreads::laco, this, i);
+    }
+}
+
+/**
+ * @brief Encerra as threads após concluir o trabalho pendente.
+ */
+PoolDeThreads::~PoolDeThreads() {
+    {
+        std::unique_lock<std::mutex> trava(_mutexEstado);
+        _concluido.wait(trava, [this] { return _pendentes.load() == 0; });
+        _encerrar = true;
+    }
+    _temTrabalho.notify_all();
+    for (std::thread& t : _threads) {
+        t.join();
+    }
+}
+
+/**
+ * @brief Submete uma tarefa, distribuindo as filas de forma circular.
+ * @param tarefa Função a executar.
+ */
+void PoolDeThreads::submeter(std::function<void()> tarefa) {
+    // Contadores antes de publicar: uma thread que pegue a tarefa já os encontra somados
+    _pendentes.fetch_add(1);
+    _naFila.fetch_add(1);
+
+    std::size_t indice = _proximaFila.fetch_add(1) % _filas.size();
+    {
+        std::lock_guard<std::mutex> travaFila(_filas[indice]->mutex);
+        _filas[indice]->tarefas.push_back(std::move(tarefa));
+    }
+
+    // Só toma a trava comum se houver thread dormindo. Como _naFila foi somado
+    // antes, uma thread que ainda não contou em _dormindo verá _naFila > 0.
+    if (_dormindo.load() > 0) {
+        { std::lock_guard<std::mutex> trava(_mutexEstado); }
+        _temTrabalho.notify_one();
+    }
+}
+
+/**
+ * @brief Retira uma tarefa da própria fila ou rouba de outra.
+ * @param indice Índice da thread.
+ * @param tarefa Saída com a tarefa.
+ * @return true se obteve uma tarefa.
+ */
+bool PoolDeThreads::obterTarefa(std::size_t indice, std::function<void()>& tarefa) {
+    // 1. Própria fila: pelo fim (tarefas mais recentes, ainda "quentes" na cache)
+    {
+        Fila& propria = *_filas[indice];
+        std::lock_guard<std::mutex> trava(propria.mutex);
+        if (!propria.tarefas.empty()) {
+            tarefa = std::move(propria.tarefas.back());
+            propria.tarefas.pop_back();
+            return true;
+        }
+    }
+
+    // 2. Roubo: pelo início da fila das outras threads
+    for (std::size_t k = 1; k < _filas.size(); ++k) {
+        Fila& vitima = *_filas[(indice + k) % _filas.size()];
+        std::lock_guard<std::mutex> trava(vitima.mutex);
+        if (!vitima.tarefas.empty()) {
+            tarefa = std::move(vitima.tarefas.front());
+            vitima.tarefas.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Laço de uma thread de trabalho.
+ * @param indice Índice da thread.
+ */
+void PoolDeThreads::laco(std::size_t indice) {
+    while (true) {
+        std::function<void()> tarefa;
+        if (!obterTarefa(indice, tarefa)) {
+            // Sem trabalho: dorme até uma submissão (ou o encerramento)
+            std::unique_lock<std::mutex> trava(_mutexEstado);
+            _dormindo.fetch_add(1);
+            _temTrabalho.wait(trava, [this] { return _naFila.load() > 0 || _encerrar; });
+            _dormindo.fetch_sub(1);
+            if (_naFila.load() == 0 && _encerrar) {
+                return;
+            }
+            continue;
+        }
+        _naFila.fetch_sub(1);
+
+        try {
+            tarefa();
+        } catch (...) {
+            std::lock_guard<std::mutex> trava(_mutexEstado);
+            if (!_erro) {
+                _erro = std::current_exception();
+            }
+        }
+
+        if (_pendentes.fetch_sub(1) == 1) {
+            { std::lock_guard<std::mutex> trava(_mutexEstado); }
+            _concluido.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Espera o término das tarefas e relança a primeira exceção.
+ */
+void PoolDeThreads::esperar() {
+    std::exception_ptr erro;
+    {
+        std::unique_lock<std::mutex> trava(_mutexEstado);
+        _concluido.wait(trava, [this] { return _pendentes.load() == 0; });
+        std::swap(erro, _erro);
+    }
+    if (erro) {
+        std::rethrow_exception(erro);
+    }
+}
+
+/**
+ * @brief Divide [0, n) em blocos, executa-os no pool e espera.
+ * @param n Número de itens.
+ * @param tamanhoBloco Itens por tarefa.
+ * @param f Função chamada com [inicio, fim) de cada bloco.
+ */
+void PoolDeThreads::paraCadaBloco(std::size_t n, std::size_t tamanhoBloco,
+                                  const std::function<void(std::size_t, std::size_t)>& f) {
+    if (tamanhoBloco == 0) {
+        tamanhoBloco = 1;
+    }
+    if (n == 0) {
+        return;
+    }
+
+    // Contador e exceção desta chamada, independentes das demais chamadas no pool.
+    // Tudo sob grupo.mutex: quem espera só vê restantes == 0 depois que a
+    // última tarefa soltou a trava e não toca mais no grupo (que está na pilha).
+    struct Grupo {
+        std::size_t restantes = 0;
+        std::mutex mutex;
+        std::condition_variable concluido;
+        std::exception_ptr erro;
+    } grupo;
+    grupo.restantes = (n + tamanhoBloco - 1) / tamanhoBloco;
+
+    for (std::size_t inicio = 0; inicio < n; inicio += tamanhoBloco) {
+        std::size_t fim = std::min(n, inicio + tamanhoBloco);
+        submeter([&f, &grupo, inicio, fim] {
+            std::exception_ptr erro;
+            try {
+                f(inicio, fim);
+            } catch (...) {
+                erro = std::current_exception();
+            }
+            std::lock_guard<std::mutex> trava(grupo.mutex);
+            if (erro && !grupo.erro) {
+                grupo.erro = erro;
+            }
+            if (--grupo.restantes == 0) {
+                grupo.concluido.notify_all();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> trava(grupo.mutex);
+    grupo.concluido.wait(trava, [&grupo] { return grupo.restantes == 0; });
+    if (grupo.erro) {
+        std::rethrow_exception(grupo.erro);
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef POOLDETHREADS_H
+#define POOLDETHREADS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // Para std::size_t
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class PoolDeThreads
+ * @brief Pool de threads com roubo de tarefas (work stealing).
+ *
+ * Cada thread tem sua própria fila: ela consome as tarefas do fim da sua
+ * fila e, quando fica sem trabalho, rouba do início da fila das outras.
+ * Assim casos de custo desigual se equilibram entre os núcleos. Os
+ * contadores de tarefas são atômicos; a trava comum (_mutexEstado) só é
+ * tomada para adormecer ou acordar threads ociosas, para guardar uma
+ * exceção e quando a última tarefa pendente termina, e não a cada tarefa.
+ *
+ * esperar() vale para o pool inteiro: espera todas as tarefas submetidas e
+ * relança a primeira exceção de qualquer uma delas. paraCadaBloco não a
+ * usa: cada chamada tem seu próprio contador e sua própria exceção, de
+ * modo que várias threads podem chamá-lo ao mesmo tempo sobre o mesmo pool.
+ * Cada bloco toma uma vez a trava do seu grupo, ao terminar.
+ */
+class PoolDeThreads {
+private:
+    /// Fila de tarefas de uma thread.
+    struct Fila {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tarefas;
+    };
+
+    /// Uma fila por thread.
+    std::vector<std::unique_ptr<Fila>> _filas;
+
+    /// Threads de trabalho.
+    std::vector<std::thread> _threads;
+
+    /// Protege as esperas abaixo e _erro.
+    std::mutex _mutexEstado;
+
+    /// Sinaliza que há tarefas na fila (ou que o pool vai encerrar).
+    std::condition_variable _temTrabalho;
+
+    /// Sinaliza que todas as tarefas submetidas terminaram.
+    std::condition_variable _concluido;
+
+    /// Tarefas ainda na fila (não retiradas por nenhuma thread).
+    /// Incrementado antes de a tarefa entrar na fila, para nunca ficar negativo.
+    std::atomic<std::size_t> _naFila{0};
+
+    /// Tarefas submetidas e ainda não concluídas.
+    std::atomic<std::size_t> _pendentes{0};
+
+    /// Threads paradas em _temTrabalho (submeter só acorda alguém se houver).
+    std::atomic<std::size_t> _dormindo{0};
+
+    /// Pedido de encerramento das threads.
+    bool _encerrar = false;
+
+    /// Próxima fila a receber uma tarefa (distribuição circular).
+    std::atomic<std::size_t> _proximaFila{0};
+
+    /// Primeira exceção lançada por uma tarefa.
+    std::exception_ptr _erro;
+
+    /**
+     * @brief Retira uma tarefa: primeiro da própria fila, depois roubando das outras.
+     * @param indice Índice da thread que procura trabalho.
+     * @param tarefa Saída com a tarefa obtida.
+     * @return true se obteve uma tarefa.
+     */
+    bool obterTarefa(std::size_t indice, std::function<void()>& tarefa);
+
+    /**
+     * @brief Laço principal de cada thread de trabalho.
+     * @param indice Índice da thread (e da sua fila).
+     */
+    void laco(std::size_t indice);
+
+public:
+    /**
+     * @brief Cria o pool.
+     * @param numeroThreads Número de threads (0 = número de núcleos da máquina).
+     */
+    explicit PoolDeThreads(std::size_t numeroThreads = 0);
+
+    /**
+     * @brief Encerra as threads (as tarefas na fila são concluídas antes).
+     */
+    ~PoolDeThreads();
+
+    PoolDeThreads(const PoolDeThreads&) = delete;
+    PoolDeThreads& operator=(const PoolDeThreads&) = delete;
+
+    /**
+     * @brief Submete uma tarefa ao pool.
+     * @param tarefa Função a executar.
+     */
+    void submeter(std::function<void()> tarefa);
+
+    /**
+     * @brief Bloqueia até que todas as tarefas submetidas ao pool terminem.
+     * Relança a primeira exceção lançada por uma tarefa de submeter, se houver.
+     */
+    void esperar();
+
+    /**
+     * @brief Executa f(inicio, fim) sobre [0, n) dividido em blocos e espera o fim.
+     * Espera só os próprios blocos e relança a primeira exceção de um deles.
+     * @param n Número total de itens.
+     * @param tamanhoBloco Número de itens por tarefa.
+     * @param f Função chamada com o intervalo [inicio, fim) de cada bloco.
+     */
+    void paraCadaBloco(std::size_t n, std::size_t tamanhoBloco,
+                       const std::function<void(std::size_t, std::size_t)>& f);
+
+    /**
+     * @brief Número de threads do pool.
+     */
+    std::size_t numeroThreads() const { return _threads.size(); }
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "PrevisaoProducao.h"
+#include <algorithm> // Para std::upper_bound
+#include <limits>    // Para std::numeric_limits
+#include <stdexcept> // Para std::runtime_error
+
+/**
+ * @brief Gera as séries de previsão de produção.
+ * @param curva Curva fw(Sw) com derivada.
+ * @param frente Resultado de Welge.
+ * @param volumePoroso Volume poroso (m³).
+ * @param vazaoInjecao Vazão de injeção (m³/dia).
+ * @return As séries de produção.
+ */
+SerieProducao PrevisaoProducao::gerar(const CurvaFluxoFracionario& curva, const ResultadoWelge& frente,
+                                      double volumePoroso, double vazaoInjecao) {
+    if (!curva.temDerivada()) {
+        throw std::runtime_error("Erro: A previsao de producao precisa da curva com dfw/dSw (gerarCurvaComDerivada).");
+    }
+
+    const std::vector<double>& sw = curva.sw();
+    const std::vector<double>& fw = curva.fw();
+    const std::vector<double>& dfw = curva.dfw();
+    const bool comTempo = volumePoroso > 0 && vazaoInjecao > 0;
+    const double oleoMovel = 1.0 - frente.swInicial; // base do fator de recuperação
+
+    SerieProducao serie;
+    const std::size_t reserva = curva.tamanho() + 2;
+    serie.pvi.reserve(reserva);
+    serie.np.reserve(reserva);
+    serie.fatorRecuperacao.reserve(reserva);
+    serie.corteAgua.reserve(reserva);
+    serie.rao.reserve(reserva);
+    if (comTempo) {
+        serie.tempo.reserve(reserva);
+    }
+
+    auto adicionar = [&](double qi, double np, double fwSaida) {
+        serie.pvi.push_back(qi);
+        serie.np.push_back(np);
+        serie.fatorRecuperacao.push_back(np / oleoMovel);
+        serie.corteAgua.push_back(fwSaida);
+        serie.rao.push_back(fwSaida < 1.0 ? fwSaida / (1.0 - fwSaida) : std::numeric_limits<double>::infinity());
+        if (comTempo) {
+            serie.tempo.push_back(qi * volumePoroso / vazaoInjecao); // t = Qi * VP / q
+        }
+    };
+
+    // 1. Antes da ruptura: só o fluido da saturação inicial chega ao produtor
+    double npRuptura = frente.swMediaRuptura - frente.swInicial;
+    adicionar(0.0, 0.0, frente.fwInicial);
+    adicionar(frente.pviRuptura, npRuptura, frente.fwInicial);
+
+    // 2. Ruptura: o corte de água salta para fw(Swf)
+    double qiAnterior = frente.pviRuptura;
+    adicionar(frente.pviRuptura, npRuptura, frente.fwFrente);
+
+    // 3. Após a ruptura: passada única pelos pontos com Sw > Swf
+    std::size_t inicio = static_cast<std::size_t>(std::upper_bound(sw.begin(), sw.end(), frente.swFrente) - sw.begin());
+    for (std::size_t i = inicio; i < curva.tamanho(); ++i) {
+        // Fim da faixa móvel: dfw se anula (fw = 1 ou Sw acima de 1 - Sorw)
+        if (dfw[i] <= 0.0 || fw[i] >= 1.0) {
+            break;
+        }
+
+        double qi = 1.0 / dfw[i];               // Qi = 1 / (dfw/dSw)
+        if (qi <= qiAnterior) {
+            continue; // trecho não côncavo: a saturação já passou pela saída
+        }
+        qiAnterior = qi;
+
+        double swMedia = sw[i] + (1.0 - fw[i]) * qi; // Sw_media = Sw2 + (1 - fw2) * Qi
+        adicionar(qi, swMedia - frente.swInicial, fw[i]);
+    }
+
+    return serie;
+}
@@ -0,0 +1,58 @@
+#ifndef PREVISAOPRODUCAO_H
+#define PREVISAOPRODUCAO_H
+
+#include "CurvaFluxoFracionario.h"
+#include "SolucionadorWelge.h"
+#include <vector>
+
+/**
+ * @struct SerieProducao
+ * @brief Séries de previsão de produção em função do volume poroso injetado.
+ *
+ * Todas as colunas têm o mesmo tamanho; volumes estão em volumes porosos (VP).
+ */
+struct SerieProducao {
+    /// Volumes porosos injetados (Qi).
+    std::vector<double> pvi;
+
+    /// Óleo acumulado produzido, Np (VP).
+    std::vector<double> np;
+
+    /// Fator de recuperação, Np / (1 - Swi).
+    std::vector<double> fatorRecuperacao;
+
+    /// Corte de água no produtor (fw na saída, condições de reservatório).
+    std::vector<double> corteAgua;
+
+    /// Razão água-óleo, RAO = fw / (1 - fw).
+    std::vector<double> rao;
+
+    /// Tempo (dias); vazio se o volume poroso e a vazão não forem informados.
+    std::vector<double> tempo;
+};
+
+/**
+ * @class PrevisaoProducao
+ * @brief Previsão de produção (Np, corte de água, RAO) pelo método de Welge.
+ *
+ * Antes da ruptura só há produção de óleo (Np = Qi * (1 - fw(Swi))). Depois
+ * dela, cada ponto da curva com Sw2 >= Swf, tomado como a saturação na
+ * saída, fornece Qi = 1 / (dfw/dSw)(Sw2), Sw_media = Sw2 + (1 - fw2) * Qi
+ * e Np = Sw_media - Swi. As séries são montadas numa única passada pela
+ * curva e sua derivada, sem novas avaliações do modelo de Kr.
+ */
+class PrevisaoProducao {
+public:
+    /**
+     * @brief Gera as séries de previsão.
+     * @param curva Curva fw(Sw) com a coluna dfw/dSw (gerarCurvaComDerivada).
+     * @param frente Resultado de Welge para a mesma curva.
+     * @param volumePoroso Volume poroso (m³); <= 0 omite a coluna de tempo.
+     * @param vazaoInjecao Vazão de injeção (m³/dia); <= 0 omite a coluna de tempo.
+     * @return As séries Np, fator de recuperação, corte de água e RAO vs Qi.
+     */
+    static SerieProducao gerar(const CurvaFluxoFracionario& curva, const ResultadoWelge& frente,
+                               double volumePoroso = 0.0, double vazaoInjecao = 0.0);
+};
+
+#endif
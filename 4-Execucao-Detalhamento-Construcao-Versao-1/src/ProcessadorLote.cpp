@@ -0,0 +1,275 @@
+#include "ProcessadorLote.h"
+#include "PoolDeThreads.h"
+#include <algorithm> // Para std::min e std::max
+#include <chrono>    // Para medir o tempo de cada caso
+#include <cmath>     // Para std::isnan
+#include <cstdio>    // Para std::snprintf
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <glob.h>
+#define LOTE_GLOB_POSIX
+#endif
+
+namespace {
+
+/**
+ * @brief Texto entre aspas para o .csv, com as aspas internas dobradas ("" = ").
+ */
+std::string campoCsv(const std::string& texto) {
+    std::string campo = "\"";
+    for (char c : texto) {
+        campo += c;
+        if (c == '"') {
+            campo += '"';
+        }
+    }
+    return campo + "\"";
+}
+
+/**
+ * @brief Indica se o argumento é um padrão de nomes (*, ? ou [).
+ */
+bool ehPadrao(const std::string& argumento) {
+    return argumento.find_first_of("*?[") != std::string::npos;
+}
+
+/**
+ * @brief Expande um padrão de nomes em arquivos existentes (ordem alfabética).
+ * @param padrao Padrão como no shell (ex: "*.in" num diretório).
+ * @return Arquivos encontrados.
+ */
+std::vector<std::string> expandirPadrao(const std::string& padrao) {
+    std::vector<std::string> arquivos;
+#ifdef LOTE_GLOB_POSIX
+    glob_t resultado;
+    if (glob(padrao.c_str(), 0, nullptr, &resultado) == 0) {
+        for (std::size_t i = 0; i < resultado.gl_pathc; ++i) {
+            if (std::filesystem::is_regular_file(resultado.gl_pathv[i])) {
+                arquivos.push_back(resultado.gl_pathv[i]);
+            }
+        }
+    }
+    globfree(&resultado);
+#else
+    // Sem glob(): o shell do Windows não expande padrões, então aceita-se
+    // apenas "*" no nome do arquivo (ex: "dir/*.in")
+    std::filesystem::path caminho(padrao);
+    std::string nome = caminho.filename().string();
+    std::size_t estrela = nome.find('*');
+    std::filesystem::path diretorio = caminho.has_parent_path() ? caminho.parent_path() : std::filesystem::path(".");
+    if (estrela == std::string::npos || nome.find_first_of("?[") != std::string::npos
+        || !std::filesystem::is_directory(diretorio)) {
+        return arquivos;
+    }
+    std::string prefixo = nome.substr(0, estrela);
+    std::string sufixo = nome.substr(estrela + 1);
+    for (const auto& entrada : std::filesystem::directory_iterator(diretorio)) {
+        std::string n = entrada.path().filename().string();
+        if (entrada.is_regular_file() && n.size() >= prefixo.size() + sufixo.size()
+            && n.compare(0, prefixo.size(), prefixo) == 0
+            && n.compare(n.size() - sufixo.size(), sufixo.size(), sufixo) == 0) {
+            arquivos.push_back(entrada.path().string());
+        }
+    }
+    std::sort(arquivos.begin(), arquivos.end());
+#endif
+    return arquivos;
+}
+
+/**
+ * @brief Formata um número da tabela (traço quando não se aplica).
+ * @param valor Valor a formatar.
+ * @param formato Formato de printf.
+ */
+std::string formatarCampo(double valor, const char* formato = "%.6g") {
+    if (std::isnan(valor)) {
+        return "-";
+    }
+    char texto[32];
+    std::snprintf(texto, sizeof(texto), formato, valor);
+    return texto;
+}
+
+} // namespace
+
+/**
+ * @brief Cria o processador.
+ * @param numeroThreads Casos simultâneos (0 = número de núcleos).
+ */
+ProcessadorLote::ProcessadorLote(std::size_t numeroThreads) : _numeroThreads(numeroThreads) {}
+
+/**
+ * @brief Expande arquivos, diretórios e padrões em arquivos de entrada.
+ * @param argumentos Argumentos da linha de comando.
+ * @return Arquivos de entrada, sem repetições.
+ */
+std::vector<std::string> ProcessadorLote::expandirEntradas(const std::vector<std::string>& argumentos) {
+    std::vector<std::string> arquivos;
+    std::unordered_set<std::string> vistos;
+    auto acrescentar = [&](const std::string& arquivo) {
+        if (vistos.insert(std::filesystem::path(arquivo).lexically_normal().string()).second) {
+            arquivos.push_back(arquivo);
+        }
+    };
+
+    for (const std::string& argumento : argumentos) {
+        // 1. Diretório: seus arquivos .in, em ordem alfabética
+        if (std::filesystem::is_directory(argumento)) {
+            std::vector<std::string> doDiretorio;
+            for (const auto& entrada : std::filesystem::directory_iterator(argumento)) {
+                if (entrada.is_regular_file() && entrada.path().extension() == ".in") {
+                    doDiretorio.push_back(entrada.path().string());
+                }
+            }
+            std::sort(doDiretorio.begin(), doDiretorio.end());
+            for (const std::string& arquivo : doDiretorio) {
+                acrescentar(arquivo);
+            }
+            continue;
+        }
+
+        // 2. Arquivo existente (mesmo que o nome tenha caracteres de padrão)
+        if (std::filesystem::exists(argumento) || !ehPadrao(argumento)) {
+            // Um arquivo inexistente vira um caso com erro, não aborta o lote
+            acrescentar(argumento);
+            continue;
+        }
+
+        // 3. Padrão de nomes
+        std::vector<std::string> doPadrao = expandirPadrao(argumento);
+        if (doPadrao.empty()) {
+            std::cerr << "Aviso: Nenhum arquivo corresponde a " << argumento << "\n";
+        }
+        for (const std::string& arquivo : doPadrao) {
+            acrescentar(arquivo);
+        }
+    }
+    return arquivos;
+}
+
+/**
+ * @brief Executa os casos no pool, um Simulador por caso.
+ * @param arquivos Arquivos de entrada.
+ * @return Um resultado por arquivo, na ordem de entrada.
+ */
+std::vector<ResultadoLote> ProcessadorLote::executar(const std::vector<std::string>& arquivos) const {
+    std::vector<ResultadoLote> resultados(arquivos.size());
+    if (arquivos.empty()) {
+        return resultados;
+    }
+
+    // 1. Threads: casos em paralelo; os núcleos que sobrarem vão para os pools internos
+    std::size_t nucleos = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::size_t casosSimultaneos = std::min(_numeroThreads > 0 ? _numeroThreads : nucleos, arquivos.size());
+    std::size_t threadsPorCaso = std::max<std::size_t>(1, nucleos / casosSimultaneos);
+    PoolDeThreads pool(casosSimultaneos);
+
+    std::mutex mutexConsole;
+    std::size_t concluidos = 0;
+
+    // 2. Um caso por tarefa; cada tarefa captura as próprias exceções
+    pool.paraCadaBloco(arquivos.size(), 1, [&](std::size_t inicio, std::size_t) {
+        ResultadoLote& r = resultados[inicio];
+        r.arquivo = arquivos[inicio];
+        r.arquivoLog = std::filesystem::path(r.arquivo).replace_extension(".log").string();
+
+        auto t0 = std::chrono::steady_clock::now();
+        std::ofstream log;
+        try {
+            // Arquivo ausente: não deixa um .log órfão para trás
+            if (!std::filesystem::is_regular_file(r.arquivo)) {
+                throw std::runtime_error("Erro: Nao foi possivel abrir o arquivo: " + r.arquivo);
+            }
+            log.open(r.arquivoLog);
+            if (!log.is_open()) {
+                throw std::runtime_error("Erro: Nao foi possivel criar o arquivo de log: " + r.arquivoLog);
+            }
+            OpcoesSimulador opcoes;
+            opcoes.saida = &log;
+            opcoes.numeroThreads = threadsPorCaso;
+            opcoes.permitirJanela = false;
+            Simulador simulador(opcoes);
+            r.resumo = simulador.executar(r.arquivo);
+            r.sucesso = true;
+        } catch (const std::exception& e) {
+            r.erro = e.what();
+        } catch (...) {
+            r.erro = "Erro: Excecao desconhecida.";
+        }
+        if (!r.sucesso && log.is_open()) {
+            log << r.erro << "\n";
+        }
+        r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        // 3. Uma linha de andamento por caso, sem misturar com as outras threads
+        std::lock_guard<std::mutex> trava(mutexConsole);
+        ++concluidos;
+        std::cout << "[" << concluidos << "/" << arquivos.size() << "] " << (r.sucesso ? "OK   " : "FALHA")
+                  << " " << r.arquivo << " (" << formatarCampo(r.segundos, "%.3f") << " s)\n";
+    });
+    return resultados;
+}
+
+/**
+ * @brief Imprime a tabela consolidada.
+ * @param resultados Resultados do lote.
+ * @param saida Destino.
+ */
+void ProcessadorLote::imprimirResumo(const std::vector<ResultadoLote>& resultados, std::ostream& saida) {
+    std::size_t largura = 7;
+    std::size_t falhas = 0;
+    double total = 0.0;
+    for (const ResultadoLote& r : resultados) {
+        largura = std::max(largura, r.arquivo.size());
+        falhas += r.sucesso ? 0 : 1;
+        total += r.segundos;
+    }
+
+    char linha[64];
+    saida << "\nResumo do lote:\n";
+    saida << std::string("Arquivo").append(largura - 7, ' ');
+    std::snprintf(linha, sizeof(linha), "  %-12s %-10s %-10s %-9s", "Modo", "Swf", "PVI (bt)", "Tempo (s)");
+    saida << linha << "  Situacao\n";
+    for (const ResultadoLote& r : resultados) {
+        saida << r.arquivo << std::string(largura - r.arquivo.size(), ' ');
+        std::snprintf(linha, sizeof(linha), "  %-12s %-10s %-10s %-9s", r.sucesso ? r.resumo.modo.c_str() : "-",
+                      formatarCampo(r.resumo.swFrente).c_str(), formatarCampo(r.resumo.pviRuptura).c_str(),
+                      formatarCampo(r.segundos, "%.3f").c_str());
+        saida << linha << "  " << (r.sucesso ? r.resumo.detalhe : r.erro) << "\n";
+    }
+    saida << resultados.size() << " casos, " << falhas << " com erro (soma dos tempos: "
+          << formatarCampo(total, "%.3f") << " s).\n";
+}
+
+/**
+ * @brief Grava a tabela consolidada em .csv.
+ * @param resultados Resultados do lote.
+ * @param arquivo Arquivo de saída.
+ */
+void ProcessadorLote::salvarResumo(const std::vector<ResultadoLote>& resultados, const std::string& arquivo) {
+    std::ofstream saida(arquivo);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro: Nao foi possivel criar o arquivo de resumo: " + arquivo);
+    }
+    saida.precision(10);
+
+    saida << "# Arquivo, Modo, Swf, PVI (bt), Tempo (s), Situacao\n";
+    for (const ResultadoLote& r : resultados) {
+        saida << campoCsv(r.arquivo) << ", " << (r.sucesso ? r.resumo.modo : "") << ", ";
+        if (!std::isnan(r.resumo.swFrente)) {
+            saida << r.resumo.swFrente;
+        }
+        saida << ", ";
+        if (!std::isnan(r.resumo.pviRuptura)) {
+            saida << r.resumo.pviRuptura;
+        }
+        saida << ", " << r.segundos << ", " << campoCsv(r.sucesso ? r.resumo.detalhe : r.erro) << "\n";
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef PROCESSADORLOTE_H
+#define PROCESSADORLOTE_H
+
+#include "Simulador.h"
+#include <cstddef> // Para std::size_t
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ResultadoLote
+ * @brief Resultado de um arquivo de entrada executado no lote.
+ */
+struct ResultadoLote {
+    /// Arquivo de entrada do caso.
+    std::string arquivo;
+
+    /// Arquivo com as mensagens de andamento do caso (<caso>.log).
+    std::string arquivoLog;
+
+    /// true se o caso terminou sem exceção.
+    bool sucesso = false;
+
+    /// Mensagem da exceção, quando o caso falhou.
+    std::string erro;
+
+    /// Tempo de execução do caso (s).
+    double segundos = 0.0;
+
+    /// Números principais do caso (válidos se sucesso).
+    ResumoCaso resumo;
+};
+
+/**
+ * @class ProcessadorLote
+ * @brief Executa vários arquivos de entrada em paralelo, isolando os erros.
+ *
+ * Cada arquivo é um caso independente, executado por um Simulador numa
+ * tarefa do PoolDeThreads. A exceção de um caso é registrada no seu
+ * resultado e não interrompe os demais. As mensagens de cada caso vão
+ * para <caso>.log, para que os logs simultâneos não se misturem; no
+ * console sai uma linha por caso concluído e, ao final, a tabela
+ * consolidada.
+ */
+class ProcessadorLote {
+private:
+    /// Casos executados ao mesmo tempo (0 = número de núcleos).
+    std::size_t _numeroThreads;
+
+public:
+    /**
+     * @brief Cria o processador.
+     * @param numeroThreads Casos simultâneos (0 = número de núcleos).
+     */
+    explicit ProcessadorLote(std::size_t numeroThreads = 0);
+
+    /**
+     * @brief Expande os argumentos da linha de comando em arquivos de entrada.
+     * Um arquivo é usado como está; um diretório contribui com seus arquivos
+     * .in (sem recursão); um padrão com *, ? ou [ é expandido como no shell.
+     * Repetições são descartadas, mantendo a primeira ocorrência.
+     * @param argumentos Arquivos, diretórios ou padrões.
+     * @return Lista de arquivos de entrada.
+     */
+    static std::vector<std::string> expandirEntradas(const std::vector<std::string>& argumentos);
+
+    /**
+     * @brief Executa todos os casos e espera o fim.
+     * @param arquivos Arquivos de entrada.
+     * @return Um resultado por arquivo, na mesma ordem de entrada.
+     */
+    std::vector<ResultadoLote> executar(const std::vector<std::string>& arquivos) const;
+
+    /**
+     * @brief Imprime a tabela consolidada do lote.
+     * @param resultados Resultados de executar().
+     * @param saida Destino da tabela.
+     */
+    static void imprimirResumo(const std::vector<ResultadoLote>& resultados, std::ostream& saida);
+
+    /**
+     * @brief Grava a tabela consolidada em .csv.
+     * @param resultados Resultados de executar().
+     * @param arquivo Arquivo de saída.
+     */
+    static void salvarResumo(const std::vector<ResultadoLote>& resultados, const std::string& arquivo);
+};
+
+#endif
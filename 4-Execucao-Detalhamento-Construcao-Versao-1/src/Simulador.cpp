@@ -2,96 +2,366 @@
 #include "CalculadoraFluxoFracionario.h"
 #include "CurvasPermeabilidadeTabelada.h"
 #include "CurvasPermeabilidadeCorey.h"
+#include "SolucionadorWelge.h"
+#include "ConfiguracaoCaso.h"
+#include "SimuladorDeslocamento1D.h"
+#include "TabelasKrRegioes.h"
+#include "PrevisaoProducao.h"
+#include "VarreduraParametros.h"
+#include "MonteCarloFluxoFracionario.h"
+#include "AjusteCorey.h"
+#include "PoolDeThreads.h"
 #include "Gnuplot.h"
+#include "GraficoSvg.h"
 
 #include <iostream>
-#include <fstream>   // Para ler arquivos (ifstream)
-#include <sstream>   // Para processar strings (stringstream)
+#include <fstream>   // Para gravar arquivos (ofstream)
 #include <stdexcept> // Para lançar erros (runtime_error)
-#include <map>
+#include <filesystem> // Para montar o nome dos arquivos de saída
+#include <chrono>     // Para medir o tempo da varredura
+#include <cstdlib>    // Para std::getenv
+#include <algorithm>  // Para std::fill e std::copy
+#include <memory>     // Para std::unique_ptr
+
+/**
+ * @brief Salva colunas em .csv e/ou .bin.
+ * @param colunas As colunas.
+ * @param arquivoBase Caminho sem a extensão final.
+ * @param formato CSV, binário ou ambos.
+ * @param descricao Início da mensagem de confirmação.
+ */
+void Simulador::salvarSeries(const std::vector<ColunaSaida>& colunas, const std::string& arquivoBase,
+                             FormatoSaida formato, const std::string& descricao) const {
+    if (formato != FormatoSaida::Binario) {
+        EscritorColunas::salvarCsv(arquivoBase + ".csv", colunas);
+        saida() << descricao << " em: " << arquivoBase << ".csv\n";
+    }
+    if (formato != FormatoSaida::Csv) {
+        EscritorColunas::salvarBinario(arquivoBase + ".bin", colunas);
+        saida() << descricao << " em: " << arquivoBase << ".bin\n";
+    }
+}
+
+/**
+ * @brief Salva a curva (Sw, Fw e, se houver, dfw/dSw).
+ * @param curva A curva de fluxo fracionário.
+ * @param arquivoBase Caminho sem a extensão final.
+ * @param formato CSV, binário ou ambos.
+ */
+void Simulador::salvarCurva(const CurvaFluxoFracionario& curva, const std::string& arquivoBase, FormatoSaida formato) const {
+    std::vector<ColunaSaida> colunas{{"Sw", &curva.sw()}, {"Fw", &curva.fw()}};
+    if (curva.temDerivada()) {
+        colunas.push_back({"dFw/dSw", &curva.dfw()});
+    }
+    salvarSeries(colunas, arquivoBase, formato, "Curva salva");
+}
+
+/**
+ * @brief Salva as séries de previsão de produção.
+ * @param serie As séries de produção.
+ * @param arquivoBase Caminho sem a extensão final.
+ * @param formato CSV, binário ou ambos.
+ */
+void Simulador::salvarPrevisao(const SerieProducao& serie, const std::string& arquivoBase, FormatoSaida formato) const {
+    std::vector<ColunaSaida> colunas{{"PVI", &serie.pvi}, {"Np (VP)", &serie.np}, {"FR", &serie.fatorRecuperacao},
+                                     {"Corte de Agua", &serie.corteAgua}, {"RAO", &serie.rao}};
+    if (!serie.tempo.empty()) {
+        colunas.push_back({"Tempo (dias)", &serie.tempo});
+    }
+    salvarSeries(colunas, arquivoBase, formato, "Previsao de producao salva");
+}
+
+/**
+ * @brief Salva a curva fw de cada região de Kr, avaliadas num único lote empacotado.
+ * @param tabelas As tabelas de Kr por região.
+ * @param passo O incremento de Saturação da malha.
+ * @param mu_o Viscosidade do Óleo.
+ * @param mu_w Viscosidade da Água.
+ * @param arquivoBase Caminho sem a extensão final.
+ * @param formato CSV, binário ou ambos.
+ */
+void Simulador::salvarRegioes(const std::vector<TabelaKrRegiao>& tabelas, double passo, double mu_o, double mu_w,
+                              const std::string& arquivoBase, FormatoSaida formato) const {
+    TabelasKrRegioes regioes(tabelas);
+    const std::vector<double> sw = CurvaFluxoFracionario::malhaUniforme(passo);
+    const std::size_t m = sw.size();
+
+    // Um lote com (região, Sw) de todas as curvas, como as células de uma malha
+    std::vector<TabelasKrRegioes::IndiceRegiao> indices(m * regioes.numeroRegioes());
+    std::vector<double> swLote(indices.size()), fwLote(indices.size());
+    for (std::size_t r = 0; r < regioes.numeroRegioes(); ++r) {
+        std::fill(indices.begin() + r * m, indices.begin() + (r + 1) * m, static_cast<TabelasKrRegioes::IndiceRegiao>(r));
+        std::copy(sw.begin(), sw.end(), swLote.begin() + r * m);
+    }
+    regioes.calcularFwLote(indices.data(), swLote.data(), fwLote.data(), indices.size(), mu_o, mu_w);
+
+    std::vector<std::vector<double>> fwRegiao(regioes.numeroRegioes());
+    std::vector<ColunaSaida> colunas{{"Sw", &sw}};
+    for (std::size_t r = 0; r < regioes.numeroRegioes(); ++r) {
+        fwRegiao[r].assign(fwLote.begin() + r * m, fwLote.begin() + (r + 1) * m);
+        colunas.push_back({"Fw(regiao " + std::to_string(regioes.numeroDaRegiao(r)) + ")", &fwRegiao[r]});
+    }
+    saida() << "Regioes de Kr: " << regioes.numeroRegioes() << " tabelas (" << regioes.memoriaBytes() << " bytes)\n";
+    salvarSeries(colunas, arquivoBase, formato, "Curvas por regiao salvas");
+}
 
 /**
  * @brief Executa a simulação completa.
  * * Este método orquestra todo o processo:
- * 1. Lê o arquivo de entrada para definir os parâmetros.
- * 2. Instancia o modelo de permeabilidade correto (Tabelado ou Corey).
- * 3. Delega o carregamento de dados detalhados para o modelo.
+ * 1. Lê o arquivo de entrada uma única vez (ConfiguracaoCaso).
+ * 2. Valida as viscosidades.
+ * 3. Constrói o modelo de permeabilidade correto (Tabelado ou Corey) a partir da configuração.
+ *    Se houver linhas VARREDURA, executa a varredura de parâmetros em
+ *    paralelo, salva o resultado consolidado e encerra; com MC_REALIZACOES,
+ *    faz o mesmo com a análise de incerteza por Monte Carlo, e com
+ *    AJUSTE_COREY ajusta um modelo de Corey à tabela de Kr.
  * 4. Instancia a calculadora.
- * 5. Gera a curva de fluxo fracionário.
- * 6. Chama o Gnuplot para exibir o resultado.
+ * 5. Gera a curva de fluxo fracionário (malha uniforme de PASSO_SW ou
+ *    adaptativa, se TOLERANCIA_CURVA for informada).
+ * 6. Calcula a frente de choque (tangente de Welge).
+ * 7. Gera a previsão de produção (Np, corte de água, RAO vs PVI) e salva
+ *    a curva e a previsão em arquivos .csv ao lado do arquivo de entrada.
+ *    Com tabelas de Kr por região (DADOS_KR_INICIO <regiao>), salva também
+ *    a curva fw de cada região, avaliadas num único lote empacotado.
+ * 8. Se NUM_CELULAS for informado, simula o deslocamento 1D e salva os perfis Sw(x).
+ * 9. Exibe o gráfico no Gnuplot ou o grava em arquivo (SAIDA_GRAFICO); sem
+ *    tela disponível (ou no modo lote), o modo de janela recai no SVG interno.
  * * @param arquivoEntrada O caminho para o arquivo de configuração .txt.
+ * @return Resumo do caso para a tabela consolidada do lote.
  */
-void Simulador::executar(const std::string& arquivoEntrada) {
-    std::cout << "Iniciando simulador...\n";
+ResumoCaso Simulador::executar(const std::string& arquivoEntrada) {
+    saida() << "Iniciando simulador...\n";
 
-    // --- 1. Leitura e Parsing do Arquivo de Entrada ---
+    // --- 1. Leitura e Parsing do Arquivo de Entrada (uma única passada) ---
 
-    double mu_o = -1.0;
-    double mu_w = -1.0;
-    std::string tipoModelo;
-    ICurvasPermeabilidade* modelo = nullptr;
+    saida() << "Lendo arquivo de configuracao: " << arquivoEntrada << "\n";
+    const ConfiguracaoCaso cfg = ConfiguracaoCaso::lerArquivo(arquivoEntrada);
+    double mu_o = cfg.mu_o();
+    double mu_w = cfg.mu_w();
+    double passo = cfg.passo();
+    ParametrosDeslocamento1D deslocamento = cfg.deslocamento(); // Só roda se NUM_CELULAS > 0
+    std::unique_ptr<const ICurvasPermeabilidade> modelo; // Liberado automaticamente em qualquer saída
+    ResumoCaso resumo;
+    // NUM_THREADS do arquivo, a menos que o chamador (modo lote) imponha outro valor
+    std::size_t numeroThreads = (_opcoes.numeroThreads > 0) ? _opcoes.numeroThreads : cfg.numeroThreads();
+
+    // --- 2. Validação e Instanciação do Modelo ---
+
+    if (mu_o <= 0 || mu_w <= 0) {
+        throw std::runtime_error("Erro: Viscosidades do oleo ou da agua nao definidas no arquivo.");
+    }
 
-    std::ifstream arq(arquivoEntrada);
-    if (!arq.is_open()) {
-        throw std::runtime_error("Erro fatal: Nao foi possivel abrir o arquivo: " + arquivoEntrada);
+    // --- 3. Construir o Modelo a partir da Configuração ---
+    // Os dados específicos do modelo já foram lidos na mesma passada
+    if (cfg.tipoModelo() == "TABELADO") {
+        saida() << "Modelo selecionado: TABELADO\n";
+        modelo = std::make_unique<const CurvasPermeabilidadeTabelada>(cfg.tabela());
+    } else if (cfg.tipoModelo() == "COREY") {
+        saida() << "Modelo selecionado: COREY\n";
+        modelo = std::make_unique<const CurvasPermeabilidadeCorey>(cfg.corey());
+    } else {
+        throw std::runtime_error("Erro: MODELO_KR nao reconhecido. Use TABELADO ou COREY.");
     }
 
-    std::cout << "Lendo arquivo de configuracao: " << arquivoEntrada << "\n";
-    std::string linha;
-    std::string palavraChave;
+    // --- 3b. Varredura de Parâmetros (opcional) ---
+    if (!cfg.eixos().empty()) {
+        VarreduraParametros varredura(modelo.get(), mu_o, mu_w, passo, cfg.eixos());
+        PoolDeThreads pool(numeroThreads);
+        saida() << "Varredura: " << varredura.numeroCasos() << " casos em "
+                  << pool.numeroThreads() << " threads...\n";
+
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<ResultadoCasoVarredura> resultados = varredura.executar(pool);
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
 
-    while (std::getline(arq, linha)) {
-        // Ignora linhas vazias ou comentários
-        if (linha.empty() || linha[0] == '#') {
-            continue;
+        std::size_t falhas = 0;
+        for (const ResultadoCasoVarredura& r : resultados) {
+            falhas += r.erro.empty() ? 0 : 1;
         }
+        std::string arquivoVarredura = std::filesystem::path(arquivoEntrada).replace_extension(".varredura.csv").string();
+        varredura.salvar(resultados, arquivoVarredura);
+        saida() << "Varredura concluida em " << segundos << " s (" << falhas << " casos com erro).\n"
+                  << "Resultado salvo em: " << arquivoVarredura << "\n";
 
-        std::stringstream ss(linha);
-        ss >> palavraChave;
+        resumo.modo = "VARREDURA";
+        resumo.detalhe = std::to_string(resultados.size()) + " casos, " + std::to_string(falhas) + " com erro";
+        return resumo;
+    }
+
+    // --- 3c. Monte Carlo (opcional) ---
+    if (cfg.monteCarlo().realizacoes > 0) {
+        MonteCarloFluxoFracionario monteCarlo(modelo.get(), mu_o, mu_w, passo, cfg.monteCarlo());
+        PoolDeThreads pool(numeroThreads);
+        saida() << "Monte Carlo: " << cfg.monteCarlo().realizacoes << " realizacoes em "
+                  << pool.numeroThreads() << " threads...\n";
 
-        if (palavraChave == "VISC_OLEO") {
-            ss >> mu_o;
-        } else if (palavraChave == "VISC_AGUA") {
-            ss >> mu_w;
-        } else if (palavraChave == "MODELO_KR") {
-            ss >> tipoModelo;
+        auto inicio = std::chrono::steady_clock::now();
+        ResultadoMonteCarlo resultado = monteCarlo.executar(pool);
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        std::string arquivoFw = std::filesystem::path(arquivoEntrada).replace_extension(".mc_fw.csv").string();
+        std::string arquivoFr = std::filesystem::path(arquivoEntrada).replace_extension(".mc_fr.csv").string();
+        MonteCarloFluxoFracionario::salvar(resultado, arquivoFw, arquivoFr);
+        saida() << "Monte Carlo concluido em " << segundos << " s (" << resultado.rejeitadas
+                  << " realizacoes descartadas).\n";
+        if (resultado.pviRupturaForaDaFaixa > 0) {
+            saida() << "Aviso: " << resultado.pviRupturaForaDaFaixa << " realizacoes com PVI na ruptura acima de MC_PVI_MAX ("
+                    << cfg.monteCarlo().pviMaximo << "); os quantis que caem nelas saem como nan. Aumente MC_PVI_MAX.\n";
         }
+        saida() << "                 P10        P50        P90\n"
+                  << "  Swf          " << resultado.swFrente[0] << "  " << resultado.swFrente[1] << "  " << resultado.swFrente[2] << "\n"
+                  << "  PVI ruptura  " << resultado.pviRuptura[0] << "  " << resultado.pviRuptura[1] << "  " << resultado.pviRuptura[2] << "\n"
+                  << "  FR ruptura   " << resultado.fatorRecuperacaoRuptura[0] << "  " << resultado.fatorRecuperacaoRuptura[1]
+                  << "  " << resultado.fatorRecuperacaoRuptura[2] << "\n"
+                  << "Envelopes salvos em: " << arquivoFw << " e " << arquivoFr << "\n";
+
+        resumo.modo = "MONTE_CARLO";
+        resumo.swFrente = resultado.swFrente[1];
+        resumo.pviRuptura = resultado.pviRuptura[1];
+        resumo.detalhe = std::to_string(resultado.aceitas) + " realizacoes";
+        if (resultado.pviRupturaForaDaFaixa > 0) {
+            resumo.detalhe += ", " + std::to_string(resultado.pviRupturaForaDaFaixa) + " com PVI acima de MC_PVI_MAX";
+        }
+        return resumo;
     }
 
-    // --- 2. Validação e Instanciação do Modelo ---
+    // --- 3d. Ajuste de Corey à tabela (opcional) ---
+    if (cfg.ajusteCoreyInicios() > 0) {
+        if (cfg.tipoModelo() != "TABELADO") {
+            throw std::runtime_error("Erro: AJUSTE_COREY exige MODELO_KR TABELADO.");
+        }
+        AjusteCorey ajuste(cfg.tabela(), cfg.ajusteCoreyInicios(), cfg.monteCarlo().semente);
+        PoolDeThreads pool(numeroThreads);
+        saida() << "Ajuste de Corey: " << cfg.ajusteCoreyInicios() << " pontos iniciais em "
+                  << pool.numeroThreads() << " threads...\n";
 
-    if (mu_o <= 0 || mu_w <= 0) {
-        throw std::runtime_error("Erro: Viscosidades do oleo ou da agua nao definidas no arquivo.");
+        ResultadoAjusteCorey resultado = ajuste.ajustar(pool);
+        std::string arquivoCorey = std::filesystem::path(arquivoEntrada).replace_extension(".corey.in").string();
+        AjusteCorey::salvarArquivoCorey(resultado, mu_o, mu_w, arquivoCorey);
+        const ParametrosCorey& p = resultado.parametros;
+        saida() << "Parametros ajustados (inicio " << resultado.inicio << ", " << resultado.iteracoes << " iteracoes):\n"
+                  << "  COREY_SWIR     = " << p.swir << "\n"
+                  << "  COREY_SORW     = " << p.sorw << "\n"
+                  << "  COREY_KRW_MAX  = " << p.krw_max << "\n"
+                  << "  COREY_KRO_MAX  = " << p.kro_max << "\n"
+                  << "  COREY_NW       = " << p.nw << "\n"
+                  << "  COREY_NO       = " << p.no << "\n"
+                  << "  RMS            = " << resultado.rms << "\n"
+                  << "Modelo ajustado salvo em: " << arquivoCorey << "\n";
+
+        resumo.modo = "AJUSTE_COREY";
+        resumo.detalhe = "RMS " + std::to_string(resultado.rms);
+        return resumo;
     }
 
-    if (tipoModelo == "TABELADO") {
-        std::cout << "Modelo selecionado: TABELADO\n";
-        modelo = new CurvasPermeabilidadeTabelada();
-    } else if (tipoModelo == "COREY") {
-        std::cout << "Modelo selecionado: COREY\n";
-        modelo = new CurvasPermeabilidadeCorey();
+    // --- 4. Criar Calculadora (Injeção de Dependência) ---
+    CalculadoraFluxoFracionario calc(mu_o, mu_w, modelo.get());
+
+    // --- 5. Gerar Curva ---
+    saida() << "Calculando curva...\n";
+    CurvaFluxoFracionario curva;
+    if (cfg.toleranciaCurva() > 0) {
+        // TOLERANCIA_CURVA: pontos concentrados onde fw tem curvatura
+        curva = calc.gerarCurvaAdaptativa(cfg.toleranciaCurva(), true);
+        saida() << "Curva adaptativa: " << curva.tamanho() << " pontos (tolerancia " << cfg.toleranciaCurva() << ")\n";
     } else {
-        throw std::runtime_error("Erro: MODELO_KR nao reconhecido. Use TABELADO ou COREY.");
+        curva = calc.gerarCurvaComDerivada(passo); // PASSO_SW, padrão de 1%
     }
 
-    // --- 3. Delegar Carregamento de Dados ---
-    // O modelo agora lê o *mesmo* arquivo para pegar seus dados específicos
-    modelo->carregarDados(arquivoEntrada);
+    // --- 6. Frente de Choque (Welge) ---
+    SolucionadorWelge welge(&calc);
+    ResultadoWelge frente = (cfg.swInicial() >= 0) ? welge.resolver(curva, cfg.swInicial()) : welge.resolver(curva);
+    saida() << "Frente de choque (Welge):\n"
+              << "  Swi            = " << frente.swInicial << "\n"
+              << "  Swf            = " << frente.swFrente << "\n"
+              << "  fw(Swf)        = " << frente.fwFrente << "\n"
+              << "  (dfw/dSw)f     = " << frente.dfwdswFrente << "\n"
+              << "  Sw media (bt)  = " << frente.swMediaRuptura << "\n"
+              << "  PVI ruptura    = " << frente.pviRuptura << "\n";
 
-    // --- 4. Criar Calculadora (Injeção de Dependência) ---
-    CalculadoraFluxoFracionario calc(mu_o, mu_w, modelo);
+    // --- 7. Previsão de Produção ---
+    double volumePoroso = cfg.temVazao() ? deslocamento.porosidade * deslocamento.areaSecao * deslocamento.comprimento : 0.0;
+    SerieProducao previsao = PrevisaoProducao::gerar(curva, frente, volumePoroso, deslocamento.vazaoInjecao);
+    salvarCurva(curva, std::filesystem::path(arquivoEntrada).replace_extension(".curva").string(), cfg.formatoSaida());
+    salvarPrevisao(previsao, std::filesystem::path(arquivoEntrada).replace_extension(".previsao").string(), cfg.formatoSaida());
 
-    // --- 5. Gerar Curva ---
-    std::cout << "Calculando curva...\n";
-    std::map<double, double> curva = calc.gerarCurvaCompleta(0.01); // passo de 1%
+    // --- 7b. Curvas fw por região (opcional) ---
+    if (!cfg.tabelasRegioes().empty()) {
+        salvarRegioes(cfg.tabelasRegioes(), passo, mu_o, mu_w,
+                      std::filesystem::path(arquivoEntrada).replace_extension(".regioes").string(), cfg.formatoSaida());
+    }
+
+    // --- 8. Deslocamento 1D (opcional) ---
+    if (deslocamento.numeroCelulas > 0) {
+        saida() << "Simulando deslocamento 1D (" << deslocamento.numeroCelulas << " celulas)...\n";
+        deslocamento.swInicial = frente.swInicial;
+        SimuladorDeslocamento1D simulador1D(calc, deslocamento);
+        PoolDeThreads pool(numeroThreads);
+        std::vector<PerfilSaturacao> perfis = simulador1D.executar(&pool);
 
-    // --- 6. Plotar ---
-    std::cout << "Plotando resultados...\n";
-    Gnuplot::plotarCurva(curva, "Curva de Fluxo Fracionario (Buckley-Leverett)");
+        // Uma coluna de Sw por tempo de saída
+        std::vector<double> x(deslocamento.numeroCelulas);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            x[i] = simulador1D.posicaoCelula(i);
+        }
+        std::vector<ColunaSaida> colunas{{"x", &x}};
+        for (const PerfilSaturacao& perfil : perfis) {
+            char tempo[32];
+            *EscritorColunas::formatar(perfil.tempo, tempo) = '\0';
+            colunas.push_back({std::string("Sw(t=") + tempo + ")", &perfil.sw});
+        }
+        salvarSeries(colunas, std::filesystem::path(arquivoEntrada).replace_extension(".perfis").string(),
+                     cfg.formatoSaida(), "Perfis de saturacao salvos");
+    }
+
+    // --- 9. Plotar ---
+    const std::string tituloGrafico = "Curva de Fluxo Fracionario (Buckley-Leverett)";
+    SaidaGrafico saidaGrafico = cfg.saidaGrafico();
+#if defined(__unix__) && !defined(__APPLE__)
+    // Em nós sem interface gráfica a janela não abriria; grava o gráfico em arquivo
+    if (saidaGrafico == SaidaGrafico::Janela && std::getenv("DISPLAY") == nullptr && std::getenv("WAYLAND_DISPLAY") == nullptr) {
+        saida() << "Sem tela disponivel (DISPLAY): grafico gravado em SVG.\n";
+        saidaGrafico = SaidaGrafico::SvgInterno;
+    }
+#endif
+    // No modo lote não se abre uma janela por caso
+    if (saidaGrafico == SaidaGrafico::Janela && !_opcoes.permitirJanela) {
+        saidaGrafico = SaidaGrafico::SvgInterno;
+    }
+    std::string arquivoGrafico = std::filesystem::path(arquivoEntrada)
+                                     .replace_extension(saidaGrafico == SaidaGrafico::Png ? ".fw.png" : ".fw.svg").string();
+    switch (saidaGrafico) {
+        case SaidaGrafico::Janela:
+            saida() << "Plotando resultados...\n";
+            Gnuplot::plotarCurva(curva, tituloGrafico);
+            break;
+        case SaidaGrafico::Png:
+            // Sem gnuplot não há como gerar o PNG: o erro vale para o caso
+            Gnuplot::salvarCurva(curva, tituloGrafico, arquivoGrafico);
+            saida() << "Grafico (gnuplot) salvo em: " << arquivoGrafico << "\n";
+            break;
+        case SaidaGrafico::Svg:
+            try {
+                Gnuplot::salvarCurva(curva, tituloGrafico, arquivoGrafico);
+                saida() << "Grafico (gnuplot) salvo em: " << arquivoGrafico << "\n";
+            } catch (const std::runtime_error&) {
+                // O SVG próprio dispensa o gnuplot
+                GraficoSvg::salvarCurva(curva, tituloGrafico, arquivoGrafico);
+                saida() << "Aviso: O gnuplot nao gerou o grafico; salvo sem o gnuplot em: " << arquivoGrafico << "\n";
+            }
+            break;
+        case SaidaGrafico::SvgInterno:
+            GraficoSvg::salvarCurva(curva, tituloGrafico, arquivoGrafico);
+            saida() << "Grafico salvo em: " << arquivoGrafico << "\n";
+            break;
+        case SaidaGrafico::Nenhuma:
+            break;
+    }
 
-    // --- 7. Limpeza da Memória ---
-    delete modelo;
-    modelo = nullptr;
+    saida() << "Simulacao concluida.\n";
 
-    std::cout << "Simulacao concluida.\n";
+    resumo.modo = "FLUXO";
+    resumo.swFrente = frente.swFrente;
+    resumo.pviRuptura = frente.pviRuptura;
+    return resumo;
 }
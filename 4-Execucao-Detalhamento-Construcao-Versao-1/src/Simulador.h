@@ -1,7 +1,53 @@
 #ifndef SIMULADOR_H
 #define SIMULADOR_H
 
+#include "CurvaFluxoFracionario.h"
+#include "PrevisaoProducao.h"
+#include "ConfiguracaoCaso.h"
+#include "EscritorColunas.h"
+#include <cstddef> // Para std::size_t
+#include <iostream>
+#include <limits>
 #include <string>
+#include <vector>
+
+/**
+ * @struct OpcoesSimulador
+ * @brief Ajustes de execução que não vêm do arquivo de entrada.
+ *
+ * No modo lote (vários arquivos) cada caso escreve no seu próprio log,
+ * não abre janelas e usa poucas threads internas, pois o paralelismo
+ * já está entre os casos.
+ */
+struct OpcoesSimulador {
+    /// Destino das mensagens de andamento (padrão: console).
+    std::ostream* saida = &std::cout;
+
+    /// Threads dos pools internos (0 = usar NUM_THREADS do arquivo).
+    std::size_t numeroThreads = 0;
+
+    /// Se false, SAIDA_GRAFICO JANELA é gravado em SVG em vez de abrir o gnuplot.
+    bool permitirJanela = true;
+};
+
+/**
+ * @struct ResumoCaso
+ * @brief Números principais de um caso, para a tabela consolidada do lote.
+ * Campos que não se aplicam ao modo executado ficam NaN.
+ */
+struct ResumoCaso {
+    /// Modo executado: FLUXO, VARREDURA, MONTE_CARLO ou AJUSTE_COREY.
+    std::string modo;
+
+    /// Saturação da frente de choque (P50 no Monte Carlo).
+    double swFrente = std::numeric_limits<double>::quiet_NaN();
+
+    /// PVI na ruptura (P50 no Monte Carlo).
+    double pviRuptura = std::numeric_limits<double>::quiet_NaN();
+
+    /// Informação complementar do modo (casos com erro, RMS do ajuste...).
+    std::string detalhe;
+};
 
 /**
  * @class Simulador
@@ -9,16 +55,70 @@
  *
  * Esta classe é responsável por controlar o fluxo de execução do programa:
  * ler o arquivo de entrada, instanciar os objetos corretos
- * (fazendo o 'new' dos modelos) e coordenar as chamadas
+ * (o modelo de Kr fica num std::unique_ptr, liberado ao fim do caso) e coordenar as chamadas
  * para a calculadora e o plotter.
  */
 class Simulador {
+private:
+    /// Opções de execução (destino das mensagens, threads, janela).
+    OpcoesSimulador _opcoes;
+
+    /**
+     * @brief Destino das mensagens de andamento.
+     */
+    std::ostream& saida() const { return *_opcoes.saida; }
+
+    /**
+     * @brief Salva colunas em .csv e/ou .bin, conforme o formato pedido.
+     * @param colunas As colunas a gravar.
+     * @param arquivoBase O caminho de saída sem a extensão final (ex: "caso.curva").
+     * @param formato CSV, binário ou ambos.
+     * @param descricao Início da mensagem de confirmação (ex: "Curva salva").
+     */
+    void salvarSeries(const std::vector<ColunaSaida>& colunas, const std::string& arquivoBase,
+                      FormatoSaida formato, const std::string& descricao) const;
+
+    /**
+     * @brief Salva a curva (Sw, Fw e, se houver, dfw/dSw).
+     * @param curva A curva de fluxo fracionário.
+     * @param arquivoBase O caminho de saída sem a extensão final.
+     * @param formato CSV, binário ou ambos.
+     */
+    void salvarCurva(const CurvaFluxoFracionario& curva, const std::string& arquivoBase, FormatoSaida formato) const;
+
+    /**
+     * @brief Salva as séries de previsão de produção.
+     * @param serie As séries de produção.
+     * @param arquivoBase O caminho de saída sem a extensão final.
+     * @param formato CSV, binário ou ambos.
+     */
+    void salvarPrevisao(const SerieProducao& serie, const std::string& arquivoBase, FormatoSaida formato) const;
+
+    /**
+     * @brief Salva a curva fw de cada região de Kr (DADOS_KR_INICIO <regiao>).
+     * @param tabelas As tabelas de Kr por região.
+     * @param passo O incremento de Saturação da malha.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param arquivoBase O caminho de saída sem a extensão final.
+     * @param formato CSV, binário ou ambos.
+     */
+    void salvarRegioes(const std::vector<TabelaKrRegiao>& tabelas, double passo, double mu_o, double mu_w,
+                       const std::string& arquivoBase, FormatoSaida formato) const;
+
 public:
+    /**
+     * @brief Cria o simulador.
+     * @param opcoes Opções de execução (padrão: console, janela permitida).
+     */
+    explicit Simulador(const OpcoesSimulador& opcoes = OpcoesSimulador()) : _opcoes(opcoes) {}
+
     /**
      * @brief Ponto de entrada principal da lógica do simulador.
      * @param arquivoEntrada O caminho (path) para o arquivo de configuração .txt.
+     * @return Resumo do caso (frente, ruptura, modo executado).
      */
-    void executar(const std::string& arquivoEntrada);
+    ResumoCaso executar(const std::string& arquivoEntrada);
 };
 
 #endif
@@ -0,0 +1,122 @@
+#include "SimuladorDeslocamento1D.h"
+#include "PoolDeThreads.h"
+#include <algorithm> // Para std::sort
+#include <stdexcept> // Para std::runtime_error
+
+/**
+ * @brief Construtor: valida os parâmetros e pré-tabela o fw.
+ * @param calculadora Calculadora usada para tabelar o fw.
+ * @param parametros Dados do meio e da injeção.
+ * @param intervalosTabela Número de intervalos da tabela de fw.
+ */
+SimuladorDeslocamento1D::SimuladorDeslocamento1D(const CalculadoraFluxoFracionario& calculadora,
+                                                 const ParametrosDeslocamento1D& parametros,
+                                                 std::size_t intervalosTabela)
+: _parametros(parametros), _maxDfw(0.0) {
+
+    // Validação de segurança
+    if (parametros.numeroCelulas == 0) {
+        throw std::runtime_error("Erro: NUM_CELULAS deve ser positivo.");
+    }
+    if (parametros.comprimento <= 0 || parametros.areaSecao <= 0) {
+        throw std::runtime_error("Erro: COMPRIMENTO e AREA_SECAO devem ser positivos.");
+    }
+    if (parametros.porosidade <= 0 || parametros.porosidade > 1) {
+        throw std::runtime_error("Erro: POROSIDADE deve estar em (0, 1].");
+    }
+    if (parametros.vazaoInjecao <= 0) {
+        throw std::runtime_error("Erro: VAZAO_INJECAO deve ser positiva.");
+    }
+    if (parametros.cfl <= 0 || parametros.cfl > 1) {
+        throw std::runtime_error("Erro: CFL deve estar em (0, 1].");
+    }
+    if (parametros.temposSaida.empty()) {
+        throw std::runtime_error("Erro: Informe ao menos um tempo em TEMPOS_SAIDA.");
+    }
+    if (intervalosTabela == 0) {
+        throw std::runtime_error("Erro: A tabela de fw precisa de ao menos um intervalo.");
+    }
+    std::sort(_parametros.temposSaida.begin(), _parametros.temposSaida.end());
+
+    // Pré-tabelar o fw (uma única passada em lote pelo modelo de Kr)
+    _cacheFw.tabelar(calculadora, intervalosTabela);
+
+    // Maior inclinação da tabela, para a condição CFL
+    _maxDfw = _cacheFw.maiorInclinacao();
+}
+
+/**
+ * @brief Posição do centro da célula i.
+ */
+double SimuladorDeslocamento1D::posicaoCelula(std::size_t i) const {
+    double dx = _parametros.comprimento / static_cast<double>(_parametros.numeroCelulas);
+    return (static_cast<double>(i) + 0.5) * dx;
+}
+
+/**
+ * @brief Avança um bloco de células um passo de tempo (upwind).
+ * Lê só swAtual e escreve só swNovo[inicio, fim): blocos diferentes não
+ * disputam dados. O fluxo que entra pela face esquerda do bloco é
+ * recalculado a partir da célula vizinha.
+ */
+void SimuladorDeslocamento1D::avancarBloco(const double* swAtual, double* swNovo, std::size_t inicio, std::size_t fim,
+                                           double c) const {
+    // Entrada com fw = 1 em x = 0
+    double entrada = (inicio == 0) ? 1.0 : _cacheFw.fw(swAtual[inicio - 1]);
+    for (std::size_t i = inicio; i < fim; ++i) {
+        double fluxo = _cacheFw.fw(swAtual[i]);
+        swNovo[i] = swAtual[i] - c * (fluxo - entrada);
+        entrada = fluxo;
+    }
+}
+
+/**
+ * @brief Executa o deslocamento até o último tempo de saída.
+ * @param pool Threads para dividir as células (nullptr = serial).
+ * @return Os perfis de saturação nos tempos de saída.
+ */
+std::vector<PerfilSaturacao> SimuladorDeslocamento1D::executar(PoolDeThreads* pool) const {
+    const std::size_t n = _parametros.numeroCelulas;
+    const double dx = _parametros.comprimento / static_cast<double>(n);
+
+    // Velocidade intersticial: v = q / (phi * A)
+    const double v = _parametros.vazaoInjecao / (_parametros.porosidade * _parametros.areaSecao);
+
+    // Passo de tempo estável (CFL): dt <= cfl * dx / (v * max dfw/dSw)
+    const double dtMax = (_maxDfw > 0) ? _parametros.cfl * dx / (v * _maxDfw) : _parametros.temposSaida.back();
+
+    // Malhas pequenas: uma tarefa por passo custaria mais que as células
+    if (pool != nullptr && (pool->numeroThreads() < 2 || n < 2 * CELULAS_POR_TAREFA)) {
+        pool = nullptr;
+    }
+
+    // Duas camadas de Sw (passo atual e seguinte), trocadas a cada passo
+    std::vector<double> sw(n, _parametros.swInicial);
+    std::vector<double> swNovo(n);
+    std::vector<PerfilSaturacao> perfis;
+    perfis.reserve(_parametros.temposSaida.size());
+
+    double tempo = 0.0;
+    for (double tempoSaida : _parametros.temposSaida) {
+        while (tempo < tempoSaida) {
+            // Encurta o último passo para cair exatamente no tempo de saída
+            bool ultimoPasso = (tempoSaida - tempo) <= dtMax;
+            double dt = ultimoPasso ? tempoSaida - tempo : dtMax;
+            const double c = v * dt / dx;
+
+            if (pool == nullptr) {
+                avancarBloco(sw.data(), swNovo.data(), 0, n, c);
+            } else {
+                pool->paraCadaBloco(n, CELULAS_POR_TAREFA, [&](std::size_t inicio, std::size_t fim) {
+                    avancarBloco(sw.data(), swNovo.data(), inicio, fim, c);
+                });
+            }
+            sw.swap(swNovo);
+
+            tempo = ultimoPasso ? tempoSaida : tempo + dt;
+        }
+        perfis.push_back(PerfilSaturacao{tempoSaida, sw});
+    }
+
+    return perfis;
+}
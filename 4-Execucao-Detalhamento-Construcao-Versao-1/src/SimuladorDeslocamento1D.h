@@ -0,0 +1,120 @@
+#ifndef SIMULADORDESLOCAMENTO1D_H
+#define SIMULADORDESLOCAMENTO1D_H
+
+#include "CalculadoraFluxoFracionario.h"
+#include "CacheFluxoFracionario.h"
+#include <vector>
+#include <cstddef> // Para std::size_t
+
+class PoolDeThreads;
+
+/**
+ * @struct ParametrosDeslocamento1D
+ * @brief Dados do meio e da injeção para o deslocamento 1D.
+ */
+struct ParametrosDeslocamento1D {
+    /// Número de células da malha.
+    std::size_t numeroCelulas = 0;
+
+    /// Comprimento do meio (m).
+    double comprimento = 1.0;
+
+    /// Área da seção transversal (m²).
+    double areaSecao = 1.0;
+
+    /// Porosidade (fração).
+    double porosidade = 0.2;
+
+    /// Vazão de injeção de água (m³/dia).
+    double vazaoInjecao = 1.0;
+
+    /// Saturação de água inicial no meio.
+    double swInicial = 0.0;
+
+    /// Número de Courant (fração do passo de tempo estável, <= 1).
+    double cfl = 0.9;
+
+    /// Tempos (dias) em que o perfil de saturação deve ser salvo.
+    std::vector<double> temposSaida;
+};
+
+/**
+ * @struct PerfilSaturacao
+ * @brief Perfil Sw(x) em um instante da simulação.
+ */
+struct PerfilSaturacao {
+    /// Instante do perfil (dias).
+    double tempo;
+
+    /// Saturação de água no centro de cada célula.
+    std::vector<double> sw;
+};
+
+/**
+ * @class SimuladorDeslocamento1D
+ * @brief Deslocamento de óleo por água em meio linear (Buckley-Leverett 1D).
+ *
+ * Resolve dSw/dt + v * dfw/dx = 0, com v = q / (phi * A), por volumes
+ * finitos explícitos com esquema upwind (a água entra por x = 0 com fw = 1).
+ * O passo de tempo é limitado pela condição CFL usando a maior derivada de
+ * fw, e é encurtado para cair exatamente nos tempos de saída.
+ *
+ * O fw é pré-tabelado numa malha uniforme de Sw (CacheFluxoFracionario)
+ * antes do laço de tempo, de modo que o laço das células só faz uma
+ * interpolação linear (sem chamadas virtuais). Cada passo lê uma camada
+ * de Sw e escreve outra, de modo que as células podem ser divididas em
+ * blocos entre as threads de um PoolDeThreads, com uma única sincronização
+ * por passo; malhas pequenas rodam em série.
+ *
+ * O custo é proporcional a N^2 (N células e, pela CFL, da ordem de N
+ * passos por volume poroso injetado).
+ */
+class SimuladorDeslocamento1D {
+private:
+    /// Dados do meio e da injeção.
+    ParametrosDeslocamento1D _parametros;
+
+    /// fw pré-tabelado na malha uniforme de Sw em [0, 1].
+    CacheFluxoFracionario _cacheFw;
+
+    /// Maior |dfw/dSw| da tabela (para a condição CFL).
+    double _maxDfw;
+
+    /// Células por tarefa no avanço paralelo.
+    static constexpr std::size_t CELULAS_POR_TAREFA = 8192;
+
+    /**
+     * @brief Avança as células [inicio, fim) um passo de tempo.
+     * @param swAtual Sw de todas as células no início do passo.
+     * @param swNovo Saída: Sw no fim do passo.
+     * @param inicio Primeira célula do bloco.
+     * @param fim Uma após a última célula do bloco.
+     * @param c Número de Courant do passo, v * dt / dx.
+     */
+    void avancarBloco(const double* swAtual, double* swNovo, std::size_t inicio, std::size_t fim, double c) const;
+
+public:
+    /**
+     * @brief Construtor. Valida os parâmetros e pré-tabela o fw.
+     * @param calculadora Calculadora usada para tabelar o fw.
+     * @param parametros Dados do meio e da injeção.
+     * @param intervalosTabela Número de intervalos da tabela de fw.
+     */
+    SimuladorDeslocamento1D(const CalculadoraFluxoFracionario& calculadora,
+                            const ParametrosDeslocamento1D& parametros,
+                            std::size_t intervalosTabela = 16384);
+
+    /**
+     * @brief Executa o deslocamento até o último tempo de saída.
+     * @param pool Threads para dividir as células a cada passo (nullptr = serial).
+     * @return Os perfis Sw(x) em cada tempo de saída, em ordem crescente de tempo.
+     */
+    std::vector<PerfilSaturacao> executar(PoolDeThreads* pool = nullptr) const;
+
+    /**
+     * @brief Posição (m) do centro da célula i.
+     */
+    double posicaoCelula(std::size_t i) const;
+};
+
+#endif
@@ -0,0 +1,151 @@
+#include "SolucionadorWelge.h"
+#include <algorithm> // Para std::upper_bound
+#include <cmath>     // Para std::sqrt
+#include <stdexcept> // Para std::runtime_error
+
+/**
+ * @brief Construtor do solucionador.
+ * @param calculadora Calculadora para o refinamento (pode ser nula).
+ * @param tolerancia Tolerância em Sw do refinamento.
+ */
+SolucionadorWelge::SolucionadorWelge(const CalculadoraFluxoFracionario* calculadora, double tolerancia)
+: _calculadora(calculadora), _tolerancia(tolerancia) {
+    if (tolerancia < 0) {
+        throw std::runtime_error("Erro: Tolerancia do solucionador de Welge deve ser nao negativa.");
+    }
+}
+
+/**
+ * @brief Resolve a frente de choque com Swi igual à maior saturação de fw nulo.
+ * @param curva Curva fw(Sw).
+ * @return Resultado da construção de Welge.
+ */
+ResultadoWelge SolucionadorWelge::resolver(const CurvaFluxoFracionario& curva) {
+    const std::vector<double>& sw = curva.sw();
+    const std::vector<double>& fw = curva.fw();
+
+    // Percorre o trecho inicial em que a água ainda não escoa
+    double swi = curva.vazia() ? 0.0 : sw.front();
+    for (std::size_t i = 0; i < curva.tamanho() && fw[i] <= 0.0; ++i) {
+        swi = sw[i];
+    }
+    return resolver(curva, swi);
+}
+
+/**
+ * @brief Resolve a frente de choque a partir de Swi.
+ * @param curva Curva fw(Sw) em ordem crescente de Sw.
+ * @param swInicial Saturação inicial.
+ * @return Resultado da construção de Welge.
+ */
+ResultadoWelge SolucionadorWelge::resolver(const CurvaFluxoFracionario& curva, double swInicial) {
+    const std::vector<double>& sw = curva.sw();
+    const std::vector<double>& fw = curva.fw();
+    const long n = static_cast<long>(curva.tamanho());
+
+    // 1. Ponto inicial (Swi, fw(Swi)): calculado pelo modelo ou interpolado na curva
+    const long inicio = static_cast<long>(std::upper_bound(sw.begin(), sw.end(), swInicial) - sw.begin());
+    if (inicio >= n) {
+        throw std::runtime_error("Erro: Curva de fluxo fracionario nao tem pontos acima da saturacao inicial.");
+    }
+
+    double fwi;
+    if (_calculadora != nullptr) {
+        fwi = _calculadora->calcularFw(swInicial);
+    } else if (inicio == 0) {
+        fwi = fw.front();
+    } else {
+        double t = (swInicial - sw[inicio - 1]) / (sw[inicio] - sw[inicio - 1]);
+        fwi = fw[inicio - 1] + t * (fw[inicio] - fw[inicio - 1]);
+    }
+
+    auto x = [&](long j) { return j < 0 ? swInicial : sw[j]; };
+    auto y = [&](long j) { return j < 0 ? fwi : fw[j]; };
+
+    // 2. Envoltória côncava superior (cadeia monótona), começando no ponto inicial
+    _envoltoria.clear();
+    _envoltoria.push_back(-1);
+    for (long j = inicio; j < n; ++j) {
+        while (_envoltoria.size() >= 2) {
+            long o = _envoltoria[_envoltoria.size() - 2];
+            long a = _envoltoria.back();
+            double produtoVetorial = (x(a) - x(o)) * (y(j) - y(o)) - (y(a) - y(o)) * (x(j) - x(o));
+            if (produtoVetorial < 0) {
+                break; // curva para a direita: 'a' continua na envoltória
+            }
+            _envoltoria.pop_back();
+        }
+        _envoltoria.push_back(j);
+    }
+
+    // 3. O primeiro lado da envoltória é a tangente de Welge
+    long k = _envoltoria[1];
+    double swf = sw[k];
+    double fwf = fw[k];
+
+    // 4. Refinamento opcional entre os vizinhos do vértice (modelos suaves)
+    if (_calculadora != nullptr && _tolerancia > 0) {
+        double a = (k - 1 >= inicio) ? sw[k - 1] : 0.5 * (swInicial + sw[k]);
+        double b = (k + 1 < n) ? sw[k + 1] : sw[k];
+        double swRefinado = refinarTangencia(a, b, swInicial, fwi);
+        double fwRefinado = _calculadora->calcularFw(swRefinado);
+
+        // Só aceita o refinamento se a tangente ficar de fato mais inclinada
+        if ((fwRefinado - fwi) * (swf - swInicial) > (fwf - fwi) * (swRefinado - swInicial)) {
+            swf = swRefinado;
+            fwf = fwRefinado;
+        }
+    }
+
+    double inclinacao = (fwf - fwi) / (swf - swInicial);
+    if (!(inclinacao > 0)) {
+        throw std::runtime_error("Erro: Nao foi possivel determinar a frente de choque (tangente de Welge nao positiva).");
+    }
+
+    // 5. Grandezas de Welge
+    ResultadoWelge r;
+    r.swInicial = swInicial;
+    r.fwInicial = fwi;
+    r.swFrente = swf;
+    r.fwFrente = fwf;
+    r.dfwdswFrente = inclinacao;
+    r.swMediaRuptura = swf + (1.0 - fwf) / inclinacao; // Sw_media = Swf + (1 - fwf) / (dfw/dSw)f
+    r.pviRuptura = 1.0 / inclinacao;                   // Qi_bt = 1 / (dfw/dSw)f
+    return r;
+}
+
+/**
+ * @brief Maximiza (fw(S) - fwi) / (S - Swi) em [a, b] por razão áurea.
+ * @param a Limite inferior.
+ * @param b Limite superior.
+ * @param swi Saturação inicial.
+ * @param fwi Fluxo fracionário inicial.
+ * @return Saturação de tangência.
+ */
+double SolucionadorWelge::refinarTangencia(double a, double b, double swi, double fwi) const {
+    const double razao = 0.5 * (std::sqrt(5.0) - 1.0);
+
+    auto inclinacao = [&](double s) { return (_calculadora->calcularFw(s) - fwi) / (s - swi); };
+
+    double c = b - razao * (b - a);
+    double d = a + razao * (b - a);
+    double gc = inclinacao(c);
+    double gd = inclinacao(d);
+
+    while (b - a > _tolerancia) {
+        if (gc >= gd) {
+            b = d;
+            d = c;
+            gd = gc;
+            c = b - razao * (b - a);
+            gc = inclinacao(c);
+        } else {
+            a = c;
+            c = d;
+            gc = gd;
+            d = a + razao * (b - a);
+            gd = inclinacao(d);
+        }
+    }
+    return 0.5 * (a + b);
+}
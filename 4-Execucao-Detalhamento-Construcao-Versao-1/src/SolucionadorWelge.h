@@ -0,0 +1,103 @@
+#ifndef SOLUCIONADORWELGE_H
+#define SOLUCIONADORWELGE_H
+
+#include "CalculadoraFluxoFracionario.h"
+#include "CurvaFluxoFracionario.h"
+#include <vector>
+#include <cstddef> // Para std::size_t
+
+/**
+ * @struct ResultadoWelge
+ * @brief Resultado da construção de Welge (frente de choque de Buckley-Leverett).
+ */
+struct ResultadoWelge {
+    /// Saturação de água inicial do meio (Swi).
+    double swInicial;
+
+    /// Fluxo fracionário na saturação inicial, fw(Swi).
+    double fwInicial;
+
+    /// Saturação de água na frente de choque (Swf).
+    double swFrente;
+
+    /// Fluxo fracionário na frente de choque, fw(Swf).
+    double fwFrente;
+
+    /// Inclinação da tangente de Welge, (dfw/dSw) na frente.
+    double dfwdswFrente;
+
+    /// Saturação média de água atrás da frente, na ruptura.
+    double swMediaRuptura;
+
+    /// Volumes porosos injetados até a ruptura (PVI = 1 / inclinação).
+    double pviRuptura;
+};
+
+/**
+ * @class SolucionadorWelge
+ * @brief Calcula a frente de choque de Buckley-Leverett pela tangente de Welge.
+ *
+ * A tangente a partir de (Swi, fw(Swi)) é obtida como o primeiro lado da
+ * envoltória côncava superior da curva fw(Sw), construída pela cadeia
+ * monótona de Andrew em O(n) (a curva já vem ordenada por Sw). O resultado
+ * é exato para a curva poligonal amostrada; com uma calculadora associada
+ * e tolerância positiva, o ponto de tangência é refinado por razão áurea
+ * entre os vizinhos do vértice, para modelos suaves como o de Corey.
+ *
+ * A área de trabalho da envoltória é reaproveitada entre chamadas: depois
+ * da primeira curva de um dado tamanho, resolver não faz alocações.
+ */
+class SolucionadorWelge {
+private:
+    /// Calculadora usada no refinamento (pode ser nula).
+    const CalculadoraFluxoFracionario* _calculadora;
+
+    /// Tolerância em Sw do refinamento (0 desativa).
+    double _tolerancia;
+
+    /// Área de trabalho: índices dos vértices da envoltória (-1 = ponto inicial).
+    std::vector<long> _envoltoria;
+
+    /**
+     * @brief Refina o ponto de tangência entre a e b, maximizando a inclinação.
+     * @param a Limite inferior do intervalo de busca.
+     * @param b Limite superior do intervalo de busca.
+     * @param swi Saturação inicial.
+     * @param fwi Fluxo fracionário inicial.
+     * @return A saturação de tangência refinada.
+     */
+    double refinarTangencia(double a, double b, double swi, double fwi) const;
+
+public:
+    /**
+     * @brief Construtor.
+     * @param calculadora Calculadora para o refinamento (nullptr = usa só a curva).
+     * @param tolerancia Tolerância em Sw do refinamento (ex: 1e-10).
+     */
+    explicit SolucionadorWelge(const CalculadoraFluxoFracionario* calculadora = nullptr, double tolerancia = 1e-10);
+
+    /**
+     * @brief Resolve a frente de choque a partir de uma saturação inicial.
+     * @param curva Curva fw(Sw) em ordem crescente de Sw.
+     * @param swInicial Saturação de água inicial do meio (Swi).
+     * @return Swf, fw na frente, saturação média e PVI de ruptura.
+     */
+    ResultadoWelge resolver(const CurvaFluxoFracionario& curva, double swInicial);
+
+    /**
+     * @brief Resolve a frente de choque usando como Swi a maior saturação
+     * com fw nulo no início da curva (água conata imóvel).
+     * @param curva Curva fw(Sw) em ordem crescente de Sw.
+     * @return Swf, fw na frente, saturação média e PVI de ruptura.
+     */
+    ResultadoWelge resolver(const CurvaFluxoFracionario& curva);
+
+    /**
+     * @brief Vértices da envoltória côncava da última chamada a resolver.
+     * O valor -1 representa o ponto inicial (Swi, fw(Swi)); os demais são
+     * índices da curva.
+     */
+    const std::vector<long>& envoltoria() const { return _envoltoria; }
+};
+
+#endif
@@ -0,0 +1,217 @@
+#include "TabelasKrRegioes.h"
+#include "CalculadoraFluxoFracionarioEspecializada.h"
+#include "PoolDeThreads.h"
+#include <algorithm> // Para std::find, std::min e std::max
+#include <limits>    // Para std::numeric_limits
+#include <stdexcept> // Para std::runtime_error
+#include <string>
+
+namespace {
+
+/// Células por tarefa na avaliação paralela.
+const std::size_t CELULAS_POR_TAREFA = 16384;
+
+/// Células por bloco de Kr na pilha em calcularFwLote.
+const std::size_t CELULAS_POR_BLOCO = 256;
+
+} // namespace
+
+/**
+ * @brief Empacota as tabelas de todas as regiões.
+ * @param tabelas As tabelas, na ordem em que os índices serão usados.
+ */
+TabelasKrRegioes::TabelasKrRegioes(const std::vector<TabelaKrRegiao>& tabelas) {
+    if (tabelas.empty()) {
+        throw std::runtime_error("Erro: Nenhuma tabela de Kr por regiao foi informada.");
+    }
+    if (tabelas.size() > std::numeric_limits<IndiceRegiao>::max()) {
+        throw std::runtime_error("Erro: Numero de regioes de Kr acima do suportado.");
+    }
+
+    // 1. Pré-processar cada tabela como no modelo tabelado e medir o total
+    std::vector<CurvasPermeabilidadeTabelada> modelos;
+    modelos.reserve(tabelas.size());
+    std::size_t totalPontos = 0;
+    for (const TabelaKrRegiao& t : tabelas) {
+        if (std::find(_numeros.begin(), _numeros.end(), t.regiao) != _numeros.end()) {
+            throw std::runtime_error("Erro: Regiao de Kr " + std::to_string(t.regiao) + " repetida.");
+        }
+        _numeros.push_back(t.regiao);
+        modelos.emplace_back(t.tabela);
+        totalPontos += modelos.back().saturacoes().size();
+    }
+
+    // 2. Copiar para os vetores comuns, região após região
+    _regioes.reserve(modelos.size());
+    _sw.reserve(totalPontos);
+    _segmentos.reserve(totalPontos);
+    for (const CurvasPermeabilidadeTabelada& modelo : modelos) {
+        const std::vector<double>& sw = modelo.saturacoes();
+        RegiaoEmpacotada r;
+        r.inicioSw = _sw.size();
+        r.inicioSegmentos = _segmentos.size();
+        r.pontos = sw.size();
+        r.krwInicial = modelo.getKrw(sw.front());
+        r.kroInicial = modelo.getKro(sw.front());
+        r.krwFinal = modelo.getKrw(sw.back());
+        r.kroFinal = modelo.getKro(sw.back());
+        _regioes.push_back(r);
+
+        _sw.insert(_sw.end(), sw.begin(), sw.end());
+        for (std::size_t i = 0; i + 1 < sw.size(); ++i) {
+            _segmentos.push_back(modelo.segmento(i));
+        }
+    }
+}
+
+/**
+ * @brief Índice da região com um dado número do arquivo.
+ * @param numero O número da região.
+ */
+TabelasKrRegioes::IndiceRegiao TabelasKrRegioes::indiceDaRegiao(std::size_t numero) const {
+    auto it = std::find(_numeros.begin(), _numeros.end(), numero);
+    if (it == _numeros.end()) {
+        throw std::runtime_error("Erro: Regiao de Kr " + std::to_string(numero) + " nao encontrada.");
+    }
+    return static_cast<IndiceRegiao>(it - _numeros.begin());
+}
+
+/**
+ * @brief Lança um erro se algum índice de região do lote não existir.
+ * @param regiao Índices das regiões.
+ * @param n Número de células.
+ */
+void TabelasKrRegioes::validarRegioes(const IndiceRegiao* regiao, std::size_t n) const {
+    // Uma passada só de comparação, fora do laço de cálculo
+    IndiceRegiao maior = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+        maior = std::max(maior, regiao[k]);
+    }
+    if (n > 0 && maior >= _regioes.size()) {
+        throw std::runtime_error("Erro: Indice de regiao de Kr " + std::to_string(maior) + " fora da faixa.");
+    }
+}
+
+/**
+ * @brief Kr (e, se pedido, as derivadas) de um ponto de uma região.
+ * Mesmas regras do modelo tabelado: constante fora da tabela e, dentro,
+ * o polinômio do segmento em Horner.
+ */
+void TabelasKrRegioes::calcularPonto(IndiceRegiao regiao, double sw, double& krw, double& kro,
+                                     double* dkrw, double* dkro) const {
+    const RegiaoEmpacotada& r = _regioes[regiao];
+    const double* s = _sw.data() + r.inicioSw;
+
+    // Extrapolação de ponta
+    if (sw <= s[0] || r.pontos < 2) {
+        krw = r.krwInicial;
+        kro = r.kroInicial;
+        if (dkrw != nullptr) {
+            *dkrw = *dkro = 0.0;
+        }
+        return;
+    }
+    if (sw >= s[r.pontos - 1]) {
+        krw = r.krwFinal;
+        kro = r.kroFinal;
+        if (dkrw != nullptr) {
+            *dkrw = *dkro = 0.0;
+        }
+        return;
+    }
+
+    // Busca binária sem desvios nas saturações da região (contíguas): as
+    // células vêm de regiões e saturações quaisquer, e um desvio por nível
+    // seria mal previsto. Termina no último s[i] <= sw.
+    const double* base = s;
+    for (std::size_t tamanho = r.pontos; tamanho > 1;) {
+        std::size_t metade = tamanho / 2;
+        base = (base[metade] <= sw) ? base + metade : base;
+        tamanho -= metade;
+    }
+    std::size_t i = static_cast<std::size_t>(base - s);
+    const SegmentoCubicoKr& seg = _segmentos[r.inicioSegmentos + i];
+    double dx = sw - s[i];
+    krw = ((seg.krw[3] * dx + seg.krw[2]) * dx + seg.krw[1]) * dx + seg.krw[0];
+    kro = ((seg.kro[3] * dx + seg.kro[2]) * dx + seg.kro[1]) * dx + seg.kro[0];
+    if (dkrw != nullptr) {
+        *dkrw = (3.0 * seg.krw[3] * dx + 2.0 * seg.krw[2]) * dx + seg.krw[1];
+        *dkro = (3.0 * seg.kro[3] * dx + 2.0 * seg.kro[2]) * dx + seg.kro[1];
+    }
+}
+
+/**
+ * @brief Krw e Kro de um lote de células.
+ * @param regiao Índice da região de cada célula.
+ * @param sw Saturação de cada célula.
+ * @param krw Vetor de saída para Krw.
+ * @param kro Vetor de saída para Kro.
+ * @param n Número de células.
+ */
+void TabelasKrRegioes::calcularKrLote(const IndiceRegiao* regiao, const double* sw, double* krw, double* kro,
+                                      std::size_t n) const {
+    validarRegioes(regiao, n);
+    for (std::size_t k = 0; k < n; ++k) {
+        calcularPonto(regiao[k], sw[k], krw[k], kro[k], nullptr, nullptr);
+    }
+}
+
+/**
+ * @brief Krw, Kro e as derivadas de um lote de células.
+ * @param regiao Índice da região de cada célula.
+ * @param sw Saturação de cada célula.
+ * @param krw Vetor de saída para Krw.
+ * @param kro Vetor de saída para Kro.
+ * @param dkrw Vetor de saída para dKrw/dSw.
+ * @param dkro Vetor de saída para dKro/dSw.
+ * @param n Número de células.
+ */
+void TabelasKrRegioes::calcularKrDerivadaLote(const IndiceRegiao* regiao, const double* sw, double* krw, double* kro,
+                                              double* dkrw, double* dkro, std::size_t n) const {
+    validarRegioes(regiao, n);
+    for (std::size_t k = 0; k < n; ++k) {
+        calcularPonto(regiao[k], sw[k], krw[k], kro[k], &dkrw[k], &dkro[k]);
+    }
+}
+
+/**
+ * @brief fw de um lote de células.
+ * @param regiao Índice da região de cada célula.
+ * @param sw Saturação de cada célula.
+ * @param fw Vetor de saída para fw.
+ * @param n Número de células.
+ * @param mu_o Viscosidade do Óleo.
+ * @param mu_w Viscosidade da Água.
+ */
+void TabelasKrRegioes::calcularFwLote(const IndiceRegiao* regiao, const double* sw, double* fw, std::size_t n,
+                                      double mu_o, double mu_w) const {
+    if (mu_o <= 0 || mu_w <= 0) {
+        throw std::runtime_error("Erro: Viscosidades devem ser positivas.");
+    }
+    validarRegioes(regiao, n);
+
+    // Kr em blocos na pilha; fw pela mesma equação da calculadora
+    const double inversoMu_o = 1.0 / mu_o;
+    const double inversoMu_w = 1.0 / mu_w;
+    double krw[CELULAS_POR_BLOCO], kro[CELULAS_POR_BLOCO];
+    for (std::size_t inicio = 0; inicio < n; inicio += CELULAS_POR_BLOCO) {
+        std::size_t m = std::min(CELULAS_POR_BLOCO, n - inicio);
+        for (std::size_t i = 0; i < m; ++i) {
+            calcularPonto(regiao[inicio + i], sw[inicio + i], krw[i], kro[i], nullptr, nullptr);
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            fw[inicio + i] = EquacaoFluxoFracionario::fw(krw[i], kro[i], inversoMu_o, inversoMu_w);
+        }
+    }
+}
+
+/**
+ * @brief fw de um lote de células, dividido entre as threads do pool.
+ * Cada tarefa escreve só no seu trecho de fw; as tabelas são só lidas.
+ */
+void TabelasKrRegioes::calcularFwLote(const IndiceRegiao* regiao, const double* sw, double* fw, std::size_t n,
+                                      double mu_o, double mu_w, PoolDeThreads& pool) const {
+    pool.paraCadaBloco(n, CELULAS_POR_TAREFA, [&](std::size_t inicio, std::size_t fim) {
+        calcularFwLote(regiao + inicio, sw + inicio, fw + inicio, fim - inicio, mu_o, mu_w);
+    });
+}
@@ -0,0 +1,169 @@
+#ifndef TABELASKRREGIOES_H
+#define TABELASKRREGIOES_H
+
+#include "CurvasPermeabilidadeTabelada.h"
+#include <cstddef> // Para std::size_t
+#include <cstdint> // Para std::uint32_t
+#include <vector>
+
+class PoolDeThreads;
+
+/**
+ * @struct TabelaKrRegiao
+ * @brief Tabela de Kr de uma região (bloco DADOS_KR_INICIO <regiao> ... FIM_DADOS).
+ */
+struct TabelaKrRegiao {
+    /// Número da região (tipo de rocha) como escrito no arquivo.
+    std::size_t regiao = 0;
+
+    /// As linhas da tabela e o modo de interpolação.
+    TabelaKr tabela;
+};
+
+/**
+ * @class TabelasKrRegioes
+ * @brief Tabelas de Kr de várias regiões, empacotadas para avaliação por célula.
+ *
+ * Cada região é pré-processada como em CurvasPermeabilidadeTabelada
+ * (ordenação, linhas repetidas, PCHIP) e copiada para dois vetores
+ * contíguos comuns a todas as regiões: as saturações e os coeficientes dos
+ * segmentos (SegmentoCubicoKr, uma linha de cache por segmento; no modo
+ * linear c2 = c3 = 0). Uma região é só um par de deslocamentos nesses
+ * vetores, de modo que dezenas de tabelas pequenas ficam juntas na memória
+ * em vez de espalhadas em 3 vetores por tabela.
+ *
+ * A avaliação em lote recebe, para cada célula, o índice da região (posição
+ * na ordem do arquivo, ver indiceDaRegiao) e Sw. O objeto é imutável depois
+ * de construído: várias threads podem avaliar lotes ao mesmo tempo.
+ */
+class TabelasKrRegioes {
+public:
+    /// Índice de região por célula (4 bytes, para não pesar no lote).
+    using IndiceRegiao = std::uint32_t;
+
+private:
+    /**
+     * @struct RegiaoEmpacotada
+     * @brief Onde uma região está nos vetores empacotados e seus valores de ponta.
+     */
+    struct RegiaoEmpacotada {
+        /// Primeira saturação da região em _sw.
+        std::size_t inicioSw;
+
+        /// Primeiro segmento da região em _segmentos.
+        std::size_t inicioSegmentos;
+
+        /// Número de linhas da tabela (após a limpeza).
+        std::size_t pontos;
+
+        /// Kr abaixo da primeira linha (extrapolação de ponta).
+        double krwInicial, kroInicial;
+
+        /// Kr acima da última linha.
+        double krwFinal, kroFinal;
+    };
+
+    /// Números das regiões, na ordem do arquivo.
+    std::vector<std::size_t> _numeros;
+
+    /// Deslocamentos de cada região.
+    std::vector<RegiaoEmpacotada> _regioes;
+
+    /// Saturações de todas as regiões, em sequência.
+    std::vector<double> _sw;
+
+    /// Coeficientes dos segmentos de todas as regiões, em sequência.
+    std::vector<SegmentoCubicoKr> _segmentos;
+
+    /**
+     * @brief Calcula Kr de um ponto de uma região.
+     * @param regiao Índice da região (já validado).
+     * @param sw A saturação de água.
+     * @param krw Saída: Krw.
+     * @param kro Saída: Kro.
+     * @param dkrw Saída opcional: dKrw/dSw (nullptr para não calcular).
+     * @param dkro Saída opcional: dKro/dSw.
+     */
+    void calcularPonto(IndiceRegiao regiao, double sw, double& krw, double& kro, double* dkrw, double* dkro) const;
+
+    /**
+     * @brief Lança um erro se algum índice de região do lote não existir.
+     */
+    void validarRegioes(const IndiceRegiao* regiao, std::size_t n) const;
+
+public:
+    /**
+     * @brief Empacota as tabelas de todas as regiões.
+     * @param tabelas As tabelas, na ordem em que os índices serão usados.
+     */
+    explicit TabelasKrRegioes(const std::vector<TabelaKrRegiao>& tabelas);
+
+    /// Número de regiões.
+    std::size_t numeroRegioes() const { return _regioes.size(); }
+
+    /// Número (do arquivo) da região de índice i.
+    std::size_t numeroDaRegiao(std::size_t i) const { return _numeros[i]; }
+
+    /**
+     * @brief Índice da região com um dado número do arquivo.
+     * @param numero O número da região (DADOS_KR_INICIO <numero>).
+     * @return O índice a usar nas chamadas em lote.
+     */
+    IndiceRegiao indiceDaRegiao(std::size_t numero) const;
+
+    /// Bytes ocupados pelas tabelas empacotadas.
+    std::size_t memoriaBytes() const {
+        return _sw.size() * sizeof(double) + _segmentos.size() * sizeof(SegmentoCubicoKr)
+               + _regioes.size() * sizeof(RegiaoEmpacotada);
+    }
+
+    /**
+     * @brief Calcula Krw e Kro de um lote de células de regiões quaisquer.
+     * @param regiao Índice da região de cada célula (n valores).
+     * @param sw Saturação de água de cada célula (n valores).
+     * @param krw Vetor de saída para Krw.
+     * @param kro Vetor de saída para Kro.
+     * @param n Número de células.
+     */
+    void calcularKrLote(const IndiceRegiao* regiao, const double* sw, double* krw, double* kro, std::size_t n) const;
+
+    /**
+     * @brief Calcula Krw, Kro e as derivadas em relação a Sw de um lote de células.
+     * @param regiao Índice da região de cada célula.
+     * @param sw Saturação de água de cada célula.
+     * @param krw Vetor de saída para Krw.
+     * @param kro Vetor de saída para Kro.
+     * @param dkrw Vetor de saída para dKrw/dSw.
+     * @param dkro Vetor de saída para dKro/dSw.
+     * @param n Número de células.
+     */
+    void calcularKrDerivadaLote(const IndiceRegiao* regiao, const double* sw, double* krw, double* kro,
+                                double* dkrw, double* dkro, std::size_t n) const;
+
+    /**
+     * @brief Calcula o fluxo fracionário de um lote de células.
+     * @param regiao Índice da região de cada célula.
+     * @param sw Saturação de água de cada célula.
+     * @param fw Vetor de saída para fw.
+     * @param n Número de células.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     */
+    void calcularFwLote(const IndiceRegiao* regiao, const double* sw, double* fw, std::size_t n,
+                        double mu_o, double mu_w) const;
+
+    /**
+     * @brief Calcula o fluxo fracionário de um lote, dividido entre as threads do pool.
+     * @param regiao Índice da região de cada célula.
+     * @param sw Saturação de água de cada célula.
+     * @param fw Vetor de saída para fw.
+     * @param n Número de células.
+     * @param mu_o Viscosidade do Óleo (cPoise).
+     * @param mu_w Viscosidade da Água (cPoise).
+     * @param pool As threads de trabalho.
+     */
+    void calcularFwLote(const IndiceRegiao* regiao, const double* sw, double* fw, std::size_t n,
+                        double mu_o, double mu_w, PoolDeThreads& pool) const;
+};
+
+#endif
@@ -0,0 +1,181 @@
+#include "VarreduraParametros.h"
+#include "CalculadoraFluxoFracionario.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+/// Casos por tarefa do pool (amortiza o custo de agendamento).
+const std::size_t CASOS_POR_TAREFA = 16;
+
+/**
+ * @brief Atribui o valor de um eixo ao campo correspondente do caso.
+ */
+void atribuir(ResultadoCasoVarredura& caso, const std::string& parametro, double valor) {
+    if (parametro == "VISC_OLEO")          caso.mu_o = valor;
+    else if (parametro == "VISC_AGUA")     caso.mu_w = valor;
+    else if (parametro == "COREY_SWIR")    caso.corey.swir = valor;
+    else if (parametro == "COREY_SORW")    caso.corey.sorw = valor;
+    else if (parametro == "COREY_KRW_MAX") caso.corey.krw_max = valor;
+    else if (parametro == "COREY_KRO_MAX") caso.corey.kro_max = valor;
+    else if (parametro == "COREY_NW")      caso.corey.nw = valor;
+    else if (parametro == "COREY_NO")      caso.corey.no = valor;
+}
+
+} // namespace
+
+/**
+ * @brief Construtor: valida os eixos contra o modelo base.
+ */
+VarreduraParametros::VarreduraParametros(const ICurvasPermeabilidade* modeloBase, double mu_o, double mu_w, double passo,
+                                         const std::vector<EixoVarredura>& eixos)
+: _modeloBase(modeloBase), _corey(false), _coreyBase{0, 0, 0, 0, 0, 0},
+  _mu_o(mu_o), _mu_w(mu_w), _passo(passo), _eixos(eixos), _variaCorey(false) {
+
+    if (modeloBase == nullptr) {
+        throw std::runtime_error("Erro: Varredura recebeu um modelo de permeabilidade nulo.");
+    }
+
+    const CurvasPermeabilidadeCorey* corey = dynamic_cast<const CurvasPermeabilidadeCorey*>(modeloBase);
+    if (corey != nullptr) {
+        _corey = true;
+        _coreyBase = corey->getParametros();
+    }
+
+    for (const EixoVarredura& eixo : _eixos) {
+        if (eixo.valores.empty()) {
+            throw std::runtime_error("Erro: VARREDURA " + eixo.parametro + " sem valores.");
+        }
+        if (eixo.parametro.compare(0, 6, "COREY_") == 0) {
+            if (!_corey) {
+                throw std::runtime_error("Erro: VARREDURA " + eixo.parametro + " exige MODELO_KR COREY.");
+            }
+            _variaCorey = true;
+        }
+    }
+}
+
+/**
+ * @brief Número total de casos.
+ */
+std::size_t VarreduraParametros::numeroCasos() const {
+    std::size_t n = 1;
+    for (const EixoVarredura& eixo : _eixos) {
+        n *= eixo.valores.size();
+    }
+    return n;
+}
+
+/**
+ * @brief Calcula um caso: curva com derivada e frente de Welge.
+ * @param indice Índice do caso.
+ * @param welge Solucionador reaproveitado no bloco.
+ * @param kr Kr do modelo base na malha, ou nullptr.
+ * @param curvaKr Curva na malha de kr, reaproveitada no bloco.
+ * @return O resultado do caso.
+ */
+ResultadoCasoVarredura VarreduraParametros::calcularCaso(std::size_t indice, SolucionadorWelge& welge,
+                                                         const KrNaMalha* kr, CurvaFluxoFracionario& curvaKr) const {
+    ResultadoCasoVarredura caso{};
+    caso.mu_o = _mu_o;
+    caso.mu_w = _mu_w;
+    caso.corey = _coreyBase;
+
+    // Decomposição do índice em base mista (último eixo varia mais rápido)
+    for (std::size_t k = _eixos.size(); k-- > 0;) {
+        const EixoVarredura& eixo = _eixos[k];
+        atribuir(caso, eixo.parametro, eixo.valores[indice % eixo.valores.size()]);
+        indice /= eixo.valores.size();
+    }
+
+    try {
+        if (_variaCorey) {
+            // Modelo próprio do caso (barato: só 6 parâmetros)
+            CurvasPermeabilidadeCorey modelo(caso.corey);
+            CalculadoraFluxoFracionario calc(caso.mu_o, caso.mu_w, &modelo);
+            caso.frente = welge.resolver(calc.gerarCurvaCompleta(_passo));
+        } else if (kr != nullptr) {
+            // Só as viscosidades mudam: Kr já avaliado, resta a equação de fw,
+            // escrita na curva do bloco (sem alocar nem copiar Sw)
+            kr->fwNaMalha(caso.mu_o, caso.mu_w, curvaKr.fw().data());
+            caso.frente = welge.resolver(curvaKr);
+        } else {
+            // O modelo do arquivo é compartilhado (avaliação só de leitura)
+            CalculadoraFluxoFracionario calc(caso.mu_o, caso.mu_w, _modeloBase);
+            caso.frente = welge.resolver(calc.gerarCurvaCompleta(_passo));
+        }
+    } catch (const std::exception& e) {
+        caso.erro = e.what();
+    }
+    return caso;
+}
+
+/**
+ * @brief Executa todos os casos no pool.
+ * @param pool Pool de threads.
+ * @return Um resultado por caso.
+ */
+std::vector<ResultadoCasoVarredura> VarreduraParametros::executar(PoolDeThreads& pool) const {
+    std::vector<ResultadoCasoVarredura> resultados(numeroCasos());
+
+    // Sem eixos de Corey, Kr é o mesmo em todos os casos: uma avaliação só,
+    // lida por todas as threads. Se falhar (ex: passo inválido), cada caso
+    // é calculado do zero e registra o próprio erro.
+    KrNaMalha kr;
+    bool temKr = false;
+    if (!_variaCorey) {
+        try {
+            kr = CalculadoraFluxoFracionario(_mu_o, _mu_w, _modeloBase).avaliarKrNaMalha(_passo);
+            temKr = true;
+        } catch (const std::exception&) {
+            temKr = false;
+        }
+    }
+
+    pool.paraCadaBloco(resultados.size(), CASOS_POR_TAREFA, [&](std::size_t inicio, std::size_t fim) {
+        SolucionadorWelge welge; // área de trabalho reaproveitada no bloco
+        CurvaFluxoFracionario curvaKr(temKr ? kr.sw.size() : 0);
+        if (temKr) {
+            curvaKr.sw() = kr.sw;
+        }
+        for (std::size_t i = inicio; i < fim; ++i) {
+            resultados[i] = calcularCaso(i, welge, temKr ? &kr : nullptr, curvaKr);
+        }
+    });
+
+    return resultados;
+}
+
+/**
+ * @brief Salva o resultado consolidado.
+ * @param resultados Resultados dos casos.
+ * @param arquivo Arquivo de saída.
+ */
+void VarreduraParametros::salvar(const std::vector<ResultadoCasoVarredura>& resultados, const std::string& arquivo) const {
+    std::ofstream saida(arquivo);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro: Nao foi possivel criar o arquivo da varredura: " + arquivo);
+    }
+    saida.precision(10);
+
+    saida << "# Caso, VISC_OLEO, VISC_AGUA";
+    if (_corey) {
+        saida << ", COREY_SWIR, COREY_SORW, COREY_KRW_MAX, COREY_KRO_MAX, COREY_NW, COREY_NO";
+    }
+    saida << ", Swi, Swf, Fw(Swf), dFw/dSw(Swf), Sw media (bt), PVI (bt), Erro\n";
+
+    for (std::size_t i = 0; i < resultados.size(); ++i) {
+        const ResultadoCasoVarredura& r = resultados[i];
+        saida << i << ", " << r.mu_o << ", " << r.mu_w;
+        if (_corey) {
+            saida << ", " << r.corey.swir << ", " << r.corey.sorw << ", " << r.corey.krw_max
+                  << ", " << r.corey.kro_max << ", " << r.corey.nw << ", " << r.corey.no;
+        }
+        if (r.erro.empty()) {
+            saida << ", " << r.frente.swInicial << ", " << r.frente.swFrente << ", " << r.frente.fwFrente
+                  << ", " << r.frente.dfwdswFrente << ", " << r.frente.swMediaRuptura << ", " << r.frente.pviRuptura << ",\n";
+        } else {
+            saida << ", , , , , , , \"" << r.erro << "\"\n";
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef VARREDURAPARAMETROS_H
+#define VARREDURAPARAMETROS_H
+
+#include "ICurvasPermeabilidade.h"
+#include "ConfiguracaoCaso.h"
+#include "CurvasPermeabilidadeCorey.h"
+#include "SolucionadorWelge.h"
+#include "CalculadoraFluxoFracionario.h"
+#include "PoolDeThreads.h"
+#include <string>
+#include <vector>
+#include <cstddef> // Para std::size_t
+
+/**
+ * @struct ResultadoCasoVarredura
+ * @brief Parâmetros e resultados de um caso da varredura.
+ */
+struct ResultadoCasoVarredura {
+    /// Viscosidade do óleo do caso (cPoise).
+    double mu_o;
+
+    /// Viscosidade da água do caso (cPoise).
+    double mu_w;
+
+    /// Parâmetros de Corey do caso (só usados quando o modelo é Corey).
+    ParametrosCorey corey;
+
+    /// Frente de choque (Welge) do caso.
+    ResultadoWelge frente;
+
+    /// Mensagem de erro; vazia se o caso foi calculado com sucesso.
+    std::string erro;
+};
+
+/**
+ * @class VarreduraParametros
+ * @brief Varredura de sensibilidade sobre viscosidades e parâmetros de Corey.
+ *
+ * Avalia o produto cartesiano dos eixos declarados no arquivo de entrada
+ * (linhas "VARREDURA <PARAMETRO> v1 v2 ..." ou "VARREDURA <PARAMETRO>
+ * inicio:fim:passo", interpretadas por ConfiguracaoCaso). Os casos não são materializados: o índice de cada
+ * caso é decomposto em base mista para obter seus valores. Os casos são
+ * agrupados em blocos e distribuídos num PoolDeThreads com roubo de
+ * tarefas; cada caso escreve na sua posição do vetor de resultados, de
+ * modo que a saída não depende do número de threads. Um caso com erro
+ * é registrado sem interromper os demais.
+ *
+ * Quando só as viscosidades variam, o modelo de Kr do arquivo é avaliado
+ * uma única vez na malha (KrNaMalha) e cada caso só aplica a equação de fw.
+ */
+class VarreduraParametros {
+private:
+    /// Modelo de Kr do arquivo de entrada (compartilhado, só leitura).
+    const ICurvasPermeabilidade* _modeloBase;
+
+    /// Indica se o modelo base é Corey (necessário para variar COREY_*).
+    bool _corey;
+
+    /// Parâmetros de Corey do arquivo (valores fora dos eixos).
+    ParametrosCorey _coreyBase;
+
+    /// Viscosidade do óleo do arquivo (cPoise).
+    double _mu_o;
+
+    /// Viscosidade da água do arquivo (cPoise).
+    double _mu_w;
+
+    /// Passo de saturação das curvas.
+    double _passo;
+
+    /// Eixos da varredura.
+    std::vector<EixoVarredura> _eixos;
+
+    /// Indica se algum eixo varia parâmetros de Corey (exige um modelo por caso).
+    bool _variaCorey;
+
+    /**
+     * @brief Calcula um caso da varredura.
+     * @param indice Índice do caso no produto cartesiano.
+     * @param welge Solucionador reaproveitado entre os casos do mesmo bloco.
+     * @param kr Kr do modelo base já avaliado na malha (nullptr: calcula o caso do zero).
+     * @param curvaKr Curva na malha de kr (Sw preenchido), reaproveitada no bloco; fw é reescrito.
+     * @return Parâmetros e resultados do caso.
+     */
+    ResultadoCasoVarredura calcularCaso(std::size_t indice, SolucionadorWelge& welge, const KrNaMalha* kr,
+                                        CurvaFluxoFracionario& curvaKr) const;
+
+public:
+    /**
+     * @brief Construtor.
+     * @param modeloBase Modelo de Kr já carregado do arquivo.
+     * @param mu_o Viscosidade do óleo base (cPoise).
+     * @param mu_w Viscosidade da água base (cPoise).
+     * @param passo Passo de saturação das curvas.
+     * @param eixos Parâmetros variados e seus valores.
+     */
+    VarreduraParametros(const ICurvasPermeabilidade* modeloBase, double mu_o, double mu_w, double passo,
+                        const std::vector<EixoVarredura>& eixos);
+
+    /**
+     * @brief Número total de casos (produto dos tamanhos dos eixos).
+     */
+    std::size_t numeroCasos() const;
+
+    /**
+     * @brief Executa todos os casos no pool de threads.
+     * @param pool Pool onde os casos serão executados.
+     * @return Um resultado por caso, na ordem do produto cartesiano.
+     */
+    std::vector<ResultadoCasoVarredura> executar(PoolDeThreads& pool) const;
+
+    /**
+     * @brief Salva o resultado consolidado em um arquivo .csv.
+     * @param resultados Resultados de executar.
+     * @param arquivo O caminho do arquivo de saída.
+     */
+    void salvar(const std::vector<ResultadoCasoVarredura>& resultados, const std::string& arquivo) const;
+};
+
+#endif
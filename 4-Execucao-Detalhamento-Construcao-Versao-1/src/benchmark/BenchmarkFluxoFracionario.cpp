@@ -0,0 +1,572 @@
+/**
+ * @file BenchmarkFluxoFracionario.cpp
+ * @brief Microbenchmarks dos caminhos críticos do cálculo de fluxo fracionário.
+ *
+ * Programa separado do fw_calc (tem seu próprio main). Para compilar, a
+ * partir do diretório src:
+ *
+ *     g++ -std=c++17 -O2 -pthread -I. benchmark/BenchmarkFluxoFracionario.cpp \
+ *         $(ls *.cpp | grep -v '^main.cpp$') -o fw_bench
+ *
+ * Uso: ./fw_bench [--repeticoes N] [--filtro texto] [--json arquivo.json]
+ *
+ * Cada medida é repetida N vezes (padrão 15); cada repetição dura pelo
+ * menos ~20 ms, ajustando-se o número de chamadas internas. A tabela mostra
+ * a mediana, o mínimo e o desvio padrão em ns por ponto, e os pontos/s da
+ * mediana. O arquivo JSON traz os mesmos números para acompanhar regressões.
+ */
+#include "CalculadoraFluxoFracionario.h"
+#include "CacheFluxoFracionario.h"
+#include "ModeloFluxoFracionario.h"
+#include "TabelasKrRegioes.h"
+#include "CurvasPermeabilidadeCorey.h"
+#include "CurvasPermeabilidadeTabelada.h"
+#include "ConfiguracaoCaso.h"
+#include "EscritorColunas.h"
+#include "GeradorPhilox.h"
+
+#include <algorithm>  // Para std::sort
+#include <chrono>
+#include <cmath>      // Para std::sqrt e std::fabs
+#include <cstdio>     // Para std::printf
+#include <cstdlib>    // Para std::strtoul
+#include <filesystem> // Para o diretório temporário
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Duração mínima de uma repetição (s).
+const double TEMPO_MINIMO_REPETICAO = 0.02;
+
+/// Semente das saturações aleatórias (resultados comparáveis entre execuções).
+const std::uint64_t SEMENTE = 20240101;
+
+/// Acumula resultados para que o compilador não elimine os cálculos.
+volatile double sumidouro = 0.0;
+
+/**
+ * @struct Medida
+ * @brief Estatística de um benchmark, em ns por ponto.
+ */
+struct Medida {
+    std::string nome;
+    std::size_t pontos = 0;     ///< Pontos processados por chamada.
+    std::size_t chamadas = 0;   ///< Chamadas por repetição.
+    std::size_t repeticoes = 0;
+    double minimo = 0.0;
+    double mediana = 0.0;
+    double media = 0.0;
+    double desvio = 0.0;
+};
+
+/**
+ * @class Bancada
+ * @brief Executa, mede e registra os benchmarks.
+ */
+class Bancada {
+private:
+    std::size_t _repeticoes;
+    std::string _filtro;
+    std::vector<Medida> _medidas;
+
+public:
+    Bancada(std::size_t repeticoes, const std::string& filtro) : _repeticoes(repeticoes), _filtro(filtro) {}
+
+    /**
+     * @brief Mede f(), que processa 'pontos' pontos por chamada.
+     * @param nome Nome do benchmark (usado também pelo filtro).
+     * @param pontos Pontos processados por chamada.
+     * @param f Função medida.
+     */
+    void medir(const std::string& nome, std::size_t pontos, const std::function<void()>& f) {
+        if (!_filtro.empty() && nome.find(_filtro) == std::string::npos) {
+            return;
+        }
+        using Relogio = std::chrono::steady_clock;
+
+        // 1. Aquecimento e calibração: dobra as chamadas até passar do tempo mínimo
+        std::size_t chamadas = 1;
+        for (;;) {
+            auto t0 = Relogio::now();
+            for (std::size_t c = 0; c < chamadas; ++c) {
+                f();
+            }
+            double s = std::chrono::duration<double>(Relogio::now() - t0).count();
+            if (s >= TEMPO_MINIMO_REPETICAO || chamadas >= (std::size_t(1) << 30)) {
+                break;
+            }
+            chamadas *= 2;
+        }
+
+        // 2. Repetições medidas
+        std::vector<double> ns(_repeticoes);
+        for (std::size_t r = 0; r < _repeticoes; ++r) {
+            auto t0 = Relogio::now();
+            for (std::size_t c = 0; c < chamadas; ++c) {
+                f();
+            }
+            double s = std::chrono::duration<double>(Relogio::now() - t0).count();
+            ns[r] = s * 1e9 / static_cast<double>(chamadas * pontos);
+        }
+
+        // 3. Estatísticas
+        Medida m;
+        m.nome = nome;
+        m.pontos = pontos;
+        m.chamadas = chamadas;
+        m.repeticoes = _repeticoes;
+        for (double v : ns) {
+            m.media += v;
+        }
+        m.media /= static_cast<double>(ns.size());
+        for (double v : ns) {
+            m.desvio += (v - m.media) * (v - m.media);
+        }
+        m.desvio = ns.size() > 1 ? std::sqrt(m.desvio / static_cast<double>(ns.size() - 1)) : 0.0;
+        std::sort(ns.begin(), ns.end());
+        m.minimo = ns.front();
+        m.mediana = (ns.size() % 2 == 1) ? ns[ns.size() / 2] : 0.5 * (ns[ns.size() / 2 - 1] + ns[ns.size() / 2]);
+
+        std::printf("%-44s %10zu %11.3f %11.3f %9.3f %14.4g\n", nome.c_str(), pontos, m.mediana, m.minimo,
+                    m.desvio, 1e9 / m.mediana);
+        std::fflush(stdout);
+        _medidas.push_back(m);
+    }
+
+    /**
+     * @brief Grava os resultados em JSON.
+     * @param arquivo Caminho do arquivo .json.
+     */
+    void salvarJson(const std::string& arquivo) const {
+        std::ofstream saida(arquivo);
+        if (!saida.is_open()) {
+            throw std::runtime_error("Erro: Nao foi possivel criar o arquivo JSON: " + arquivo);
+        }
+        saida.precision(6);
+        saida << "{\n"
+              << "  \"formato\": 1,\n"
+#if defined(__VERSION__)
+              << "  \"compilador\": \"" << __VERSION__ << "\",\n"
+#endif
+              << "  \"threads_hw\": " << std::thread::hardware_concurrency() << ",\n"
+              << "  \"repeticoes\": " << _repeticoes << ",\n"
+              << "  \"resultados\": [\n";
+        for (std::size_t i = 0; i < _medidas.size(); ++i) {
+            const Medida& m = _medidas[i];
+            saida << "    {\"nome\": \"" << m.nome << "\", \"pontos\": " << m.pontos
+                  << ", \"chamadas_por_repeticao\": " << m.chamadas
+                  << ", \"ns_por_ponto\": {\"mediana\": " << m.mediana << ", \"minimo\": " << m.minimo
+                  << ", \"media\": " << m.media << ", \"desvio\": " << m.desvio << "}"
+                  << ", \"pontos_por_s\": " << 1e9 / m.mediana << "}"
+                  << (i + 1 < _medidas.size() ? ",\n" : "\n");
+        }
+        saida << "  ]\n}\n";
+    }
+};
+
+/**
+ * @brief Saturações uniformes em [0, 1), reprodutíveis.
+ */
+std::vector<double> saturacoesAleatorias(std::size_t n) {
+    GeradorPhilox gerador(SEMENTE);
+    std::vector<double> sw(n);
+    for (std::size_t i = 0; i < n; i += 2) {
+        double u1, u2;
+        gerador.uniformes(i / 2, 0, u1, u2);
+        sw[i] = u1;
+        if (i + 1 < n) {
+            sw[i + 1] = u2;
+        }
+    }
+    return sw;
+}
+
+/**
+ * @brief Parâmetros de Corey usados em todos os benchmarks.
+ */
+ParametrosCorey parametrosCorey() {
+    return ParametrosCorey{0.2, 0.15, 0.4, 0.9, 2.5, 1.8};
+}
+
+/**
+ * @brief Tabela de Kr com 'linhas' pontos amostrados da curva de Corey.
+ * @param linhas Número de linhas.
+ * @param indiceUniforme Baldes do índice uniforme (0 = busca binária).
+ */
+TabelaKr tabelaSintetica(std::size_t linhas, std::size_t indiceUniforme) {
+    CurvasPermeabilidadeCorey corey(parametrosCorey());
+    TabelaKr t;
+    t.indiceUniforme = indiceUniforme;
+    for (std::size_t i = 0; i < linhas; ++i) {
+        double sw = 0.2 + 0.65 * static_cast<double>(i) / static_cast<double>(linhas - 1);
+        t.sw.push_back(sw);
+        t.krw.push_back(corey.getKrw(sw));
+        t.kro.push_back(corey.getKro(sw));
+    }
+    return t;
+}
+
+/**
+ * @brief Texto de um arquivo de entrada tabelado com 'linhas' linhas de Kr.
+ */
+std::string deckTabelado(std::size_t linhas) {
+    TabelaKr t = tabelaSintetica(linhas, 0);
+    std::string texto = "# Deck sintetico do benchmark\nVISC_OLEO 1.5\nVISC_AGUA 0.8\nMODELO_KR TABELADO\nDADOS_KR_INICIO\n";
+    char linha[96];
+    for (std::size_t i = 0; i < linhas; ++i) {
+        std::snprintf(linha, sizeof(linha), "%.6f %.6f %.6f\n", t.sw[i], t.krw[i], t.kro[i]);
+        texto += linha;
+    }
+    texto += "FIM_DADOS\n";
+    return texto;
+}
+
+/**
+ * @brief Maior erro da interpolação linear de uma curva contra a calculadora.
+ * Amostra cada intervalo da curva em 63 pontos internos (muito mais denso
+ * que os pontos testados pela amostragem adaptativa).
+ */
+double erroCurvaDensa(const CalculadoraFluxoFracionario& calc, const CurvaFluxoFracionario& curva) {
+    const std::vector<double>& sw = curva.sw();
+    const std::vector<double>& fw = curva.fw();
+    double maior = 0.0;
+    for (std::size_t i = 0; i + 1 < curva.tamanho(); ++i) {
+        for (int k = 1; k < 64; ++k) {
+            double t = k / 64.0;
+            double interpolado = fw[i] + t * (fw[i + 1] - fw[i]);
+            maior = std::max(maior, std::fabs(interpolado - calc.calcularFw(sw[i] + t * (sw[i + 1] - sw[i]))));
+        }
+    }
+    return maior;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t repeticoes = 15;
+    std::string filtro;
+    std::string arquivoJson = "benchmark.json";
+    for (int i = 1; i < argc; ++i) {
+        std::string argumento = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Uso: ./fw_bench [--repeticoes N] [--filtro texto] [--json arquivo.json]\n";
+            return 1;
+        }
+        if (argumento == "--repeticoes") {
+            repeticoes = std::max<std::size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argumento == "--filtro") {
+            filtro = argv[++i];
+        } else if (argumento == "--json") {
+            arquivoJson = argv[++i];
+        } else {
+            std::cerr << "Erro: Opcao desconhecida: " << argumento << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        Bancada bancada(repeticoes, filtro);
+        std::printf("%-44s %10s %11s %11s %9s %14s\n", "Benchmark", "Pontos", "ns/pt (med)", "ns/pt (min)",
+                    "Desvio", "Pontos/s");
+
+        const std::size_t N = 1 << 16;
+        const std::vector<double> sw = saturacoesAleatorias(N);
+        std::vector<double> a(N), b(N), c(N), d(N);
+
+        // --- 1. Modelo de Corey ---
+        CurvasPermeabilidadeCorey corey(parametrosCorey());
+        bancada.medir("corey/getKrw+getKro", N, [&] {
+            double s = 0.0;
+            for (double x : sw) {
+                s += corey.getKrw(x) + corey.getKro(x);
+            }
+            sumidouro = sumidouro + s;
+        });
+        bancada.medir("corey/calcularKrLote", N, [&] {
+            corey.calcularKrLote(sw.data(), a.data(), b.data(), N);
+            sumidouro = sumidouro + a[N / 2];
+        });
+        bancada.medir("corey/calcularKrDerivadaLote", N, [&] {
+            corey.calcularKrDerivadaLote(sw.data(), a.data(), b.data(), c.data(), d.data(), N);
+            sumidouro = sumidouro + c[N / 2];
+        });
+
+        // Expoentes inteiros e semi-inteiros (multiplicações) contra um expoente geral
+        for (double expoente : {2.0, 2.5, 4.0, 2.3}) {
+            ParametrosCorey p = parametrosCorey();
+            p.nw = p.no = expoente;
+            CurvasPermeabilidadeCorey coreyN(p);
+            char sufixo[32];
+            std::snprintf(sufixo, sizeof(sufixo), "/n=%g", expoente);
+            bancada.medir(std::string("corey/getKrw+getKro") + sufixo, N, [&] {
+                double s = 0.0;
+                for (double x : sw) {
+                    s += coreyN.getKrw(x) + coreyN.getKro(x);
+                }
+                sumidouro = sumidouro + s;
+            });
+            bancada.medir(std::string("corey/calcularKrLote") + sufixo, N, [&] {
+                coreyN.calcularKrLote(sw.data(), a.data(), b.data(), N);
+                sumidouro = sumidouro + a[N / 2];
+            });
+        }
+
+        // --- 2. Modelo tabelado (interpolação), de 10 a 10^5 linhas ---
+        for (std::size_t linhas : {10, 100, 1000, 10000, 100000}) {
+            for (std::size_t baldes : {std::size_t(0), linhas}) {
+                CurvasPermeabilidadeTabelada tabelada(tabelaSintetica(linhas, baldes));
+                std::string sufixo = "/" + std::to_string(linhas) + (baldes ? "/indice" : "/binaria");
+                bancada.medir("tabelado/getKrw+getKro" + sufixo, N, [&] {
+                    double s = 0.0;
+                    for (double x : sw) {
+                        s += tabelada.getKrw(x) + tabelada.getKro(x);
+                    }
+                    sumidouro = sumidouro + s;
+                });
+                bancada.medir("tabelado/calcularKrLote" + sufixo, N, [&] {
+                    tabelada.calcularKrLote(sw.data(), a.data(), b.data(), N);
+                    sumidouro = sumidouro + a[N / 2];
+                });
+            }
+
+            // Cúbica PCHIP (coeficientes pré-calculados), com o índice uniforme
+            TabelaKr t = tabelaSintetica(linhas, linhas);
+            t.interpolacao = InterpolacaoKr::Pchip;
+            CurvasPermeabilidadeTabelada pchip(t);
+            bancada.medir("tabelado/calcularKrLote/" + std::to_string(linhas) + "/pchip", N, [&] {
+                pchip.calcularKrLote(sw.data(), a.data(), b.data(), N);
+                sumidouro = sumidouro + a[N / 2];
+            });
+        }
+
+        // --- 3. Calculadora: ponto a ponto, em lote e curva completa ---
+        CurvasPermeabilidadeTabelada tabela100(tabelaSintetica(100, 100));
+        const ICurvasPermeabilidade* modelos[] = {&corey, &tabela100};
+        const char* nomesModelos[] = {"corey", "tabelado100"};
+        for (int m = 0; m < 2; ++m) {
+            CalculadoraFluxoFracionario calc(1.5, 0.8, modelos[m]);
+            std::string prefixo = std::string("calculadora/") + nomesModelos[m];
+            bancada.medir(prefixo + "/calcularFw", N, [&] {
+                double s = 0.0;
+                for (double x : sw) {
+                    s += calc.calcularFw(x);
+                }
+                sumidouro = sumidouro + s;
+            });
+            // Mesmo laço ponto a ponto, dentro de um único despacho
+            bancada.medir(prefixo + "/despachar/calcularFw", N, [&] {
+                double s = calc.despachar([&](const auto& especializada) {
+                    double soma = 0.0;
+                    for (double x : sw) {
+                        soma += especializada.calcularFw(x);
+                    }
+                    return soma;
+                });
+                sumidouro = sumidouro + s;
+            });
+            bancada.medir(prefixo + "/calcularFwLote", N, [&] {
+                calc.calcularFwLote(sw.data(), a.data(), N);
+                sumidouro = sumidouro + a[N / 2];
+            });
+            for (double passo : {1e-2, 1e-3, 1e-4, 1e-5}) {
+                std::size_t pontos = calc.gerarCurvaCompleta(passo).tamanho();
+                char nome[96];
+                std::snprintf(nome, sizeof(nome), "%s/gerarCurvaCompleta/passo=%g", prefixo.c_str(), passo);
+                bancada.medir(nome, pontos, [&] { sumidouro = sumidouro + calc.gerarCurvaCompleta(passo).fw()[0]; });
+            }
+
+            // Cache de fw com erro limitado: consulta e reconstrução
+            for (double erro : {1e-4, 1e-6}) {
+                CacheFluxoFracionario cache(calc, erro);
+                char nome[96];
+                std::snprintf(nome, sizeof(nome), "%s/cache/erro=%g/fw", prefixo.c_str(), erro);
+                bancada.medir(nome, N, [&] {
+                    double s = 0.0;
+                    for (double x : sw) {
+                        s += cache.fw(x);
+                    }
+                    sumidouro = sumidouro + s;
+                });
+                std::snprintf(nome, sizeof(nome), "%s/cache/erro=%g/reconstruir", prefixo.c_str(), erro);
+                bancada.medir(nome, cache.intervalos() + 1, [&] {
+                    cache.reconstruir(calc);
+                    sumidouro = sumidouro + cache.erroEstimado();
+                });
+                if (filtro.empty() || std::string(nome).find(filtro) != std::string::npos) {
+                    std::printf("  (%zu intervalos, %zu bytes, erro medido %.2e)\n", cache.intervalos(),
+                                cache.memoriaBytes(), cache.erroEstimado());
+                }
+            }
+
+            // Curva adaptativa: tempo e erro conferido numa amostragem densa
+            for (double tolerancia : {1e-4, 1e-6}) {
+                CurvaFluxoFracionario curva = calc.gerarCurvaAdaptativa(tolerancia, false);
+                char nome[96];
+                std::snprintf(nome, sizeof(nome), "%s/gerarCurvaAdaptativa/tol=%g", prefixo.c_str(), tolerancia);
+                bancada.medir(nome, curva.tamanho(), [&] {
+                    sumidouro = sumidouro + calc.gerarCurvaAdaptativa(tolerancia, false).fw()[0];
+                });
+                if (filtro.empty() || std::string(nome).find(filtro) != std::string::npos) {
+                    std::printf("  (%zu pontos, erro em malha densa %.2e)\n", curva.tamanho(), erroCurvaDensa(calc, curva));
+                }
+            }
+        }
+
+        // Verificação (não é medida de tempo): a curva adaptativa respeita a tolerância em toda a faixa.
+        // Corey com expoentes de 1 a 4 (com quinas em Swir e 1 - Sorw e inflexões fortes),
+        // viscosidades e tolerâncias variadas; cada curva é conferida em malha densa.
+        if (filtro.empty() || std::string("verificacao/curvaAdaptativa").find(filtro) != std::string::npos) {
+            std::size_t combinacoes = 0, acima = 0;
+            double piorRazao = 0.0;
+            for (double nw : {1.0, 1.5, 2.0, 2.5, 3.0, 4.0}) {
+                for (double no : {1.0, 1.5, 2.0, 2.5, 3.0, 4.0}) {
+                    for (double mu_o : {0.5, 1.0, 2.0, 5.0, 20.0}) {
+                        CurvasPermeabilidadeCorey modelo(ParametrosCorey{0.15, 0.2, 0.5, 0.9, nw, no});
+                        CalculadoraFluxoFracionario calc(mu_o, 1.0, &modelo);
+                        for (double tolerancia : {1e-3, 1e-4, 1e-5, 1e-6}) {
+                            double razao = erroCurvaDensa(calc, calc.gerarCurvaAdaptativa(tolerancia, false)) / tolerancia;
+                            piorRazao = std::max(piorRazao, razao);
+                            acima += (razao > 1.0) ? 1 : 0;
+                            ++combinacoes;
+                        }
+                    }
+                }
+            }
+            std::printf("verificacao/curvaAdaptativa: %zu combinacoes, %zu acima da tolerancia (pior erro/tolerancia %.2f)\n",
+                        combinacoes, acima, piorRazao);
+            if (acima > 0) {
+                throw std::runtime_error("Erro: A curva adaptativa passou da tolerancia pedida.");
+            }
+        }
+
+        // --- 3a. Sensibilidade às viscosidades: uma calculadora por par vs. Kr reaproveitado ---
+        {
+            std::vector<ParViscosidades> pares;
+            for (int i = 1; i <= 64; ++i) {
+                pares.push_back({0.25 * i, 0.8});
+            }
+            const double passo = 1e-4;
+            const std::size_t pontos = pares.size() * CalculadoraFluxoFracionario(1.5, 0.8, &corey).gerarCurvaCompleta(passo).tamanho();
+            bancada.medir("viscosidades/corey/64_pares/calculadora", pontos, [&] {
+                for (const ParViscosidades& par : pares) {
+                    sumidouro = sumidouro + CalculadoraFluxoFracionario(par.mu_o, par.mu_w, &corey).gerarCurvaCompleta(passo).fw()[1];
+                }
+            });
+            CalculadoraFluxoFracionario calc(1.5, 0.8, &corey);
+            bancada.medir("viscosidades/corey/64_pares/kr_reaproveitado", pontos, [&] {
+                sumidouro = sumidouro + calc.gerarCurvasViscosidades(passo, pares).back().fw()[1];
+            });
+            // Kr reaproveitado e uma só curva reescrita a cada par (como na varredura)
+            const KrNaMalha kr = calc.avaliarKrNaMalha(passo);
+            std::vector<double> fwPar(kr.sw.size());
+            bancada.medir("viscosidades/corey/64_pares/fwNaMalha", pontos, [&] {
+                for (const ParViscosidades& par : pares) {
+                    kr.fwNaMalha(par.mu_o, par.mu_w, fwPar.data());
+                    sumidouro = sumidouro + fwPar[1];
+                }
+            });
+        }
+
+        // --- 3b. Biblioteca: um único modelo compartilhado por várias threads ---
+        {
+            const ModeloFluxoFracionario compartilhado = ModeloFluxoFracionario::corey(1.5, 0.8, parametrosCorey());
+            const std::size_t celulas = 1 << 20; // Ex: células de uma malha em um passo de tempo
+            std::vector<double> swCelulas(celulas), fwCelulas(celulas);
+            for (std::size_t i = 0; i < celulas; ++i) {
+                swCelulas[i] = sw[i % N];
+            }
+            const std::size_t maximoThreads = std::max(1u, std::thread::hardware_concurrency());
+            for (std::size_t threads = 1; threads <= maximoThreads; threads *= 2) {
+                bancada.medir("biblioteca/compartilhado/fwLote/threads=" + std::to_string(threads), celulas, [&] {
+                    std::vector<std::thread> trabalhadores;
+                    const std::size_t bloco = (celulas + threads - 1) / threads;
+                    for (std::size_t t = 0; t < threads; ++t) {
+                        std::size_t inicio = std::min(celulas, t * bloco);
+                        std::size_t n = std::min(bloco, celulas - inicio);
+                        trabalhadores.emplace_back([&, inicio, n] {
+                            compartilhado.fwLote(swCelulas.data() + inicio, fwCelulas.data() + inicio, n);
+                        });
+                    }
+                    for (std::thread& trabalhador : trabalhadores) {
+                        trabalhador.join();
+                    }
+                    sumidouro = sumidouro + fwCelulas[celulas / 2];
+                });
+            }
+        }
+
+        // --- 3c. Várias regiões de Kr: tabelas empacotadas vs. um modelo por região ---
+        {
+            const std::size_t numeroRegioes = 32;
+            std::vector<TabelaKrRegiao> tabelas(numeroRegioes);
+            std::vector<CurvasPermeabilidadeTabelada> modelosRegiao;
+            for (std::size_t r = 0; r < numeroRegioes; ++r) {
+                tabelas[r].regiao = r + 1;
+                tabelas[r].tabela = tabelaSintetica(20 + r, 0);
+                modelosRegiao.emplace_back(tabelas[r].tabela);
+            }
+            std::vector<CalculadoraFluxoFracionario> calculadoras;
+            for (const CurvasPermeabilidadeTabelada& modelo : modelosRegiao) {
+                calculadoras.emplace_back(1.5, 0.8, &modelo);
+            }
+            TabelasKrRegioes regioes(tabelas);
+
+            // Região de cada célula espalhada de forma determinística
+            std::vector<TabelasKrRegioes::IndiceRegiao> regiaoCelula(N);
+            for (std::size_t i = 0; i < N; ++i) {
+                regiaoCelula[i] = static_cast<TabelasKrRegioes::IndiceRegiao>(((i * 2654435761u) >> 8) % numeroRegioes);
+            }
+            bancada.medir("regioes/32/calculadora_por_regiao", N, [&] {
+                double s = 0.0;
+                for (std::size_t i = 0; i < N; ++i) {
+                    s += calculadoras[regiaoCelula[i]].calcularFw(sw[i]);
+                }
+                sumidouro = sumidouro + s;
+            });
+            bancada.medir("regioes/32/empacotadas/calcularFwLote", N, [&] {
+                regioes.calcularFwLote(regiaoCelula.data(), sw.data(), a.data(), N, 1.5, 0.8);
+                sumidouro = sumidouro + a[N / 2];
+            });
+        }
+
+        // --- 4. Leitura do arquivo de entrada (pontos = linhas da tabela) ---
+        for (std::size_t linhas : {100, 10000, 200000}) {
+            const std::string texto = deckTabelado(linhas);
+            bancada.medir("entrada/interpretar/" + std::to_string(linhas) + "_linhas", linhas, [&] {
+                ConfiguracaoCaso cfg = ConfiguracaoCaso::interpretar(texto, "benchmark.in");
+                sumidouro = sumidouro + cfg.tabela().sw.back();
+            });
+        }
+
+        // --- 5. Gravação da curva (pontos = linhas gravadas) ---
+        CalculadoraFluxoFracionario calc(1.5, 0.8, &corey);
+        CurvaFluxoFracionario curva = calc.gerarCurvaComDerivada(1e-5);
+        std::vector<ColunaSaida> colunas{{"Sw", &curva.sw()}, {"Fw", &curva.fw()}, {"dFw/dSw", &curva.dfw()}};
+        std::string base = (std::filesystem::temp_directory_path() / "fw_bench_curva").string();
+        // Remove antes de gravar: reescrever um arquivo truncado força a descarga
+        // para o disco em alguns sistemas de arquivos (ext4), o que mediria o disco
+        bancada.medir("saida/csv", curva.tamanho(), [&] {
+            std::filesystem::remove(base + ".csv");
+            EscritorColunas::salvarCsv(base + ".csv", colunas);
+        });
+        bancada.medir("saida/binario", curva.tamanho(), [&] {
+            std::filesystem::remove(base + ".bin");
+            EscritorColunas::salvarBinario(base + ".bin", colunas);
+        });
+        std::filesystem::remove(base + ".csv");
+        std::filesystem::remove(base + ".bin");
+
+        bancada.salvarJson(arquivoJson);
+        std::cout << "Resultados salvos em: " << arquivoJson << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Uma exceção ocorreu: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
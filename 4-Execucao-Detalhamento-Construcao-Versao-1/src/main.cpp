@@ -1,23 +1,96 @@
 #include "Simulador.h"
+#include "ProcessadorLote.h"
+#include <cerrno>     // Para errno e ERANGE
+#include <cstdlib>    // Para std::strtoul
+#include <filesystem>
 #include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Mostra a forma de uso do programa.
+ */
+void mostrarUso() {
+    std::cerr << "Uso: ./fw_calc <caminho_para_arquivo_de_entrada>\n";
+    std::cerr << "     ./fw_calc [-j N] [-o resumo.csv] <arquivo|diretorio|padrao>...\n";
+    std::cerr << "  Com mais de uma entrada, os casos rodam em paralelo (N por vez) e\n";
+    std::cerr << "  cada caso grava suas mensagens em <caso>.log.\n";
+}
 
 int main(int argc, char* argv[]) {
     // Verifica se o usuário passou o nome do arquivo de entrada
     if (argc < 2) {
         std::cerr << "Erro: Por favor, forneça o nome do arquivo de entrada.\n";
-        std::cerr << "Uso: ./fw_calc <caminho_para_arquivo_de_entrada>\n";
+        mostrarUso();
         return 1; // Retorna um código de erro
     }
 
-    std::string arquivoEntrada = argv[1];
+    // Opções do modo lote
+    std::size_t casosSimultaneos = 0;
+    std::string arquivoResumo;
+    std::vector<std::string> entradas;
+    for (int i = 1; i < argc; ++i) {
+        std::string argumento = argv[i];
+        if ((argumento == "-j" || argumento == "-o") && i + 1 >= argc) {
+            std::cerr << "Erro: A opcao " << argumento << " exige um valor.\n";
+            mostrarUso();
+            return 1;
+        }
+        if (argumento == "-j") {
+            // Só inteiros positivos: strtoul aceitaria "abc" (0 = todos os núcleos) e "-3" (valor enorme)
+            const char* valor = argv[++i];
+            char* fim = nullptr;
+            errno = 0;
+            unsigned long n = (valor[0] >= '0' && valor[0] <= '9') ? std::strtoul(valor, &fim, 10) : 0;
+            if (fim == nullptr || *fim != '\0' || n == 0 || errno == ERANGE) {
+                std::cerr << "Erro: A opcao -j exige um inteiro positivo: '" << valor << "'.\n";
+                mostrarUso();
+                return 1;
+            }
+            casosSimultaneos = n;
+        } else if (argumento == "-o") {
+            arquivoResumo = argv[++i];
+        } else {
+            entradas.push_back(argumento);
+        }
+    }
+
+    // Um único arquivo: execução interativa, como sempre
+    if (entradas.size() == 1 && arquivoResumo.empty() && std::filesystem::is_regular_file(entradas[0])) {
+        try {
+            Simulador sim;
+            sim.executar(entradas[0]);
+        } catch (const std::exception& e) {
+            std::cerr << "Uma exceção ocorreu: " << e.what() << '\n';
+            return 1;
+        }
+        return 0; // Sucesso
+    }
 
-    try {
-        Simulador sim;
-        sim.executar(arquivoEntrada);
-    } catch (const std::exception& e) {
-        std::cerr << "Uma exceção ocorreu: " << e.what() << '\n';
+    // Vários arquivos, diretórios ou padrões: modo lote
+    std::vector<std::string> arquivos = ProcessadorLote::expandirEntradas(entradas);
+    if (arquivos.empty()) {
+        std::cerr << "Erro: Nenhum arquivo de entrada encontrado.\n";
         return 1;
     }
 
+    ProcessadorLote lote(casosSimultaneos);
+    std::vector<ResultadoLote> resultados = lote.executar(arquivos);
+    ProcessadorLote::imprimirResumo(resultados, std::cout);
+    if (!arquivoResumo.empty()) {
+        try {
+            ProcessadorLote::salvarResumo(resultados, arquivoResumo);
+            std::cout << "Resumo salvo em: " << arquivoResumo << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Uma exceção ocorreu: " << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    for (const ResultadoLote& r : resultados) {
+        if (!r.sucesso) {
+            return 1; // Algum caso falhou
+        }
+    }
     return 0; // Sucesso
 }